@@ -0,0 +1,194 @@
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE /* posix_memalign(), madvise() */
+#endif
+
+#include "allocator.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define HUGE_PAGE_SIZE (2UL * 1024UL * 1024UL)
+/* alignment malloc() and realloc() always give */
+#define MALLOC_ALIGN (2 * sizeof(void *))
+
+static void *arena_alloc_cb(void *ctx, size_t nbytes) {
+    return arena_alloc((Arena *)ctx, nbytes);
+}
+
+static void *
+arena_realloc_cb(void *ctx, void *ptr, size_t old_nbytes, size_t nbytes) {
+    (void)old_nbytes;
+    return arena_realloc((Arena *)ctx, nbytes, ptr);
+}
+
+static void arena_free_cb(void *ctx, void *ptr, size_t nbytes) {
+    /* released all together by arena_free() */
+    (void)ctx;
+    (void)ptr;
+    (void)nbytes;
+}
+
+static void *fixedbuffer_alloc_cb(void *ctx, size_t nbytes) {
+    return fixedbuffer_alloc((FixedBuffer *)ctx, nbytes);
+}
+
+static void *
+fixedbuffer_realloc_cb(void *ctx, void *ptr, size_t old_nbytes, size_t nbytes) {
+    return fixedbuffer_realloc((FixedBuffer *)ctx, ptr, old_nbytes, nbytes);
+}
+
+static void fixedbuffer_free_cb(void *ctx, void *ptr, size_t nbytes) {
+    fixedbuffer_release((FixedBuffer *)ctx, ptr, nbytes);
+}
+
+static void *pool_alloc_cb(void *ctx, size_t nbytes) {
+    Pool *pool = ctx;
+
+    if (nbytes > pool->szof)
+        return NULL;
+    return pool_alloc(pool);
+}
+
+static void *
+pool_realloc_cb(void *ctx, void *ptr, size_t old_nbytes, size_t nbytes) {
+    Pool *pool = ctx;
+
+    (void)old_nbytes;
+    // every object has a full slot
+    if (nbytes > pool->szof)
+        return NULL;
+    return ptr ? ptr : pool_alloc(pool);
+}
+
+static void pool_free_cb(void *ctx, void *ptr, size_t nbytes) {
+    (void)nbytes;
+    pool_release((Pool *)ctx, ptr);
+}
+
+typedef struct AlignedCtx {
+    size_t align;
+    bool huge_pages;
+} AlignedCtx;
+
+static inline size_t aligned_align(const AlignedCtx *c, size_t nbytes) {
+    return c->huge_pages && nbytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : c->align;
+}
+
+static void *aligned_alloc_cb(void *ctx, size_t nbytes) {
+    const AlignedCtx *c = ctx;
+    size_t align;
+    void *ptr;
+
+    align = aligned_align(c, nbytes);
+    if (align == HUGE_PAGE_SIZE)
+        // the whole huge pages must belong to the allocation
+        nbytes = (nbytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+    if (posix_memalign(&ptr, align, nbytes ? nbytes : 1) != 0)
+        return NULL;
+
+#ifdef MADV_HUGEPAGE
+    if (align == HUGE_PAGE_SIZE)
+        madvise(ptr, nbytes, MADV_HUGEPAGE);
+#endif
+
+    return ptr;
+}
+
+static void *
+aligned_realloc_cb(void *ctx, void *ptr, size_t old_nbytes, size_t nbytes) {
+    const AlignedCtx *c = ctx;
+    size_t align;
+    void *next;
+
+    align = aligned_align(c, nbytes);
+
+    // realloc() is only safe when it can't return a misaligned block: once it moved the
+    // data, a failing fallback couldn't leave the old block to the caller
+    if (align <= MALLOC_ALIGN)
+        return realloc(ptr, nbytes);
+
+    if ((next = aligned_alloc_cb(ctx, nbytes)) == NULL)
+        return NULL;
+    if (ptr) {
+        memcpy(next, ptr, old_nbytes < nbytes ? old_nbytes : nbytes);
+        free(ptr);
+    }
+
+    return next;
+}
+
+static void aligned_free_cb(void *ctx, void *ptr, size_t nbytes) {
+    (void)ctx;
+    (void)nbytes;
+    free(ptr);
+}
+
+#define ALIGNED_CTXS(huge_pages) \
+    {16, huge_pages}, {32, huge_pages}, {64, huge_pages}, {128, huge_pages}, \
+    {256, huge_pages}, {512, huge_pages}, {1024, huge_pages}, \
+    {2048, huge_pages}, {4096, huge_pages}
+
+#define ALIGNED_CTXS_PER_KIND (9)
+
+static AlignedCtx aligned_ctxs[] = {ALIGNED_CTXS(false), ALIGNED_CTXS(true)};
+
+#define ALIGNED_ALLOCATOR(i) \
+    {aligned_alloc_cb, aligned_realloc_cb, aligned_free_cb, &aligned_ctxs[i]}
+
+static const Allocator aligned_allocators[] = {
+    ALIGNED_ALLOCATOR(0),
+    ALIGNED_ALLOCATOR(1),
+    ALIGNED_ALLOCATOR(2),
+    ALIGNED_ALLOCATOR(3),
+    ALIGNED_ALLOCATOR(4),
+    ALIGNED_ALLOCATOR(5),
+    ALIGNED_ALLOCATOR(6),
+    ALIGNED_ALLOCATOR(7),
+    ALIGNED_ALLOCATOR(8),
+    ALIGNED_ALLOCATOR(9),
+    ALIGNED_ALLOCATOR(10),
+    ALIGNED_ALLOCATOR(11),
+    ALIGNED_ALLOCATOR(12),
+    ALIGNED_ALLOCATOR(13),
+    ALIGNED_ALLOCATOR(14),
+    ALIGNED_ALLOCATOR(15),
+    ALIGNED_ALLOCATOR(16),
+    ALIGNED_ALLOCATOR(17),
+};
+
+void allocator_from_arena(Allocator *a, Arena *arena) {
+    a->alloc = arena_alloc_cb;
+    a->realloc = arena_realloc_cb;
+    a->free = arena_free_cb;
+    a->ctx = arena;
+}
+
+void allocator_from_fixedbuffer(Allocator *a, FixedBuffer *fixed_buffer) {
+    a->alloc = fixedbuffer_alloc_cb;
+    a->realloc = fixedbuffer_realloc_cb;
+    a->free = fixedbuffer_free_cb;
+    a->ctx = fixed_buffer;
+}
+
+void allocator_from_pool(Allocator *a, Pool *pool) {
+    a->alloc = pool_alloc_cb;
+    a->realloc = pool_realloc_cb;
+    a->free = pool_free_cb;
+    a->ctx = pool;
+}
+
+const Allocator *allocator_aligned(size_t align, bool huge_pages) {
+    size_t i;
+
+    if (align & (align - 1))
+        return NULL;
+
+    for (i = 0; i < ALIGNED_CTXS_PER_KIND; i++) {
+        if (align <= aligned_ctxs[i].align)
+            return &aligned_allocators[i + (huge_pages ? ALIGNED_CTXS_PER_KIND : 0)];
+    }
+
+    return NULL;
+}
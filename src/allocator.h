@@ -0,0 +1,116 @@
+/**
+ * @file allocator.h
+ */
+
+#ifndef __ALLOCATOR_H__
+#define __ALLOCATOR_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "fixed_buffer.h"
+#include "pool.h"
+
+/**
+ * @brief allocator interface the containers can be constructed with
+ *
+ * a NULL Allocator means the standard malloc/realloc/free
+ */
+typedef struct Allocator {
+    void *(*alloc)(void *ctx, size_t nbytes); /**< allocate @p nbytes */
+    void *(*realloc)(void *ctx, void *ptr, size_t old_nbytes, size_t nbytes); /**< resize an allocation of @p old_nbytes */
+    void (*free)(void *ctx, void *ptr, size_t nbytes); /**< release an allocation of @p nbytes, can be a no-op */
+    void *ctx; /**< state of the allocator, passed to every call */
+} Allocator;
+
+/**
+ * @brief Allocator drawing from an Arena
+ *
+ * single allocations are never released, everything is dropped at once by arena_free()
+ *
+ * @param a Allocator
+ * @param arena Arena, must outlive the containers using @p a
+ */
+void allocator_from_arena(Allocator *a, Arena *arena);
+
+/**
+ * @brief Allocator drawing from a FixedBuffer
+ *
+ * single allocations are only released if they are the last one made,
+ * everything is dropped at once by fixedbuffer_clear().
+ * when the buffer is exhausted allocations return NULL
+ *
+ * @param a Allocator
+ * @param fixed_buffer FixedBuffer, must outlive the containers using @p a
+ */
+void allocator_from_fixedbuffer(Allocator *a, FixedBuffer *fixed_buffer);
+
+/**
+ * @brief Allocator drawing from a Pool
+ *
+ * only allocations up to the size of the Pool's objects succeed, the others return NULL.
+ * single allocations go back to the Pool, everything is dropped at once by pool_free()
+ *
+ * @param a Allocator
+ * @param pool Pool, must outlive the containers using @p a
+ */
+void allocator_from_pool(Allocator *a, Pool *pool);
+
+/**
+ * @brief Allocator returning memory aligned to @p align
+ *
+ * the alignment is kept across reallocations.
+ * with @p huge_pages, allocations of at least 2 MiB are aligned to 2 MiB and advised to use
+ * transparent huge pages (madvise(MADV_HUGEPAGE)), where the system supports it
+ *
+ * @param align power of two up to 4096
+ * @param huge_pages whether big allocations use huge pages
+ * @return static Allocator, or NULL if @p align is not supported
+ */
+const Allocator *allocator_aligned(size_t align, bool huge_pages);
+
+/**
+ * @brief allocate through @p a
+ *
+ * @param a Allocator, or NULL for malloc
+ * @param nbytes number of bytes
+ * @return the allocation
+ */
+inline void *allocator_alloc(const Allocator *a, size_t nbytes) {
+    if (a)
+        return a->alloc(a->ctx, nbytes);
+    return malloc(nbytes);
+}
+
+/**
+ * @brief reallocate through @p a
+ *
+ * @param a Allocator, or NULL for realloc
+ * @param ptr previous allocation
+ * @param old_nbytes size of the previous allocation
+ * @param nbytes number of bytes
+ * @return the allocation
+ */
+inline void *
+allocator_realloc(const Allocator *a, void *ptr, size_t old_nbytes, size_t nbytes) {
+    if (a)
+        return a->realloc(a->ctx, ptr, old_nbytes, nbytes);
+    return realloc(ptr, nbytes);
+}
+
+/**
+ * @brief release through @p a
+ *
+ * @param a Allocator, or NULL for free
+ * @param ptr allocation
+ * @param nbytes size of the allocation
+ */
+inline void allocator_free(const Allocator *a, void *ptr, size_t nbytes) {
+    if (a)
+        a->free(a->ctx, ptr, nbytes);
+    else
+        free(ptr);
+}
+
+#endif /* __ALLOCATOR_H__ */
@@ -44,7 +44,7 @@ void *arena_realloc(Arena *arena, size_t bytes, void *prev_allocation) {
             else
                 arena->head = needle;
 
-            return ((char *)next) + sizeof(ArenaNode);
+            return ((char *)needle) + sizeof(ArenaNode);
         }
     }
 
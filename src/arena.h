@@ -1,12 +1,57 @@
+/**
+ * @file arena.h
+ */
+
 #ifndef __ARENA_H__
 #define __ARENA_H__
 
+#include <stdlib.h>
+
+/**
+ * @brief header of every allocation made by the Arena
+ */
 typedef struct ArenaNode {
-    struct ArenaNode *next;
+    struct ArenaNode *next; /**< previous allocation */
 } ArenaNode;
 
+/**
+ * @brief group of allocations released all together
+ */
 typedef struct Arena {
-    ArenaNode *head;
+    ArenaNode *head; /**< last allocation */
 } Arena;
 
-#endif /* __ARENA_H__ */
\ No newline at end of file
+/**
+ * @brief initialize the Arena
+ *
+ * @param arena Arena
+ */
+void arena_init(Arena *arena);
+
+/**
+ * @brief allocate memory owned by the Arena
+ *
+ * @param arena Arena
+ * @param bytes number of bytes
+ * @return the allocation
+ */
+void *arena_alloc(Arena *arena, size_t bytes);
+
+/**
+ * @brief resize an allocation made by the Arena
+ *
+ * @param arena Arena
+ * @param bytes number of bytes
+ * @param prev_allocation allocation made by @p arena
+ * @return the allocation, or NULL if @p prev_allocation doesn't belong to @p arena
+ */
+void *arena_realloc(Arena *arena, size_t bytes, void *prev_allocation);
+
+/**
+ * @brief release all the allocations
+ *
+ * @param arena Arena
+ */
+void arena_free(Arena *arena);
+
+#endif /* __ARENA_H__ */
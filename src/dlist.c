@@ -0,0 +1,157 @@
+#include "dlist.h"
+
+#include <stdlib.h>
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static DLNode *dlnode_new(DList *list, void *data) {
+    DLNode *node;
+
+    node = allocator_alloc(list->allocator, sizeof(DLNode));
+    node->data = data;
+    node->next = NULL;
+    node->prev = NULL;
+
+    return node;
+}
+
+static inline void
+dlnode_free(DList *list, DLNode *node, Func_Free func_free) {
+    if (func_free)
+        func_free(node->data);
+    allocator_free(list->allocator, node, sizeof(DLNode));
+}
+
+/* link @p node between @p prev and @p next, either can be NULL at the ends */
+static inline void
+dlist_link(DList *list, DLNode *prev, DLNode *next, DLNode *node) {
+    node->prev = prev;
+    node->next = next;
+    if (prev)
+        prev->next = node;
+    else
+        list->head = node;
+    if (next)
+        next->prev = node;
+    else
+        list->tail = node;
+}
+
+static inline void dlist_unlink(DList *list, DLNode *node) {
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void dlist_init(DList *list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->allocator = NULL;
+}
+
+void dlist_init_in(DList *list, const Allocator *allocator) {
+    dlist_init(list);
+    list->allocator = allocator;
+}
+
+void dlist_free(DList *list, Func_Free func_free) {
+    DLNode *curr, *next;
+
+    for (curr = list->head; curr; curr = next) {
+        next = curr->next;
+        dlnode_free(list, curr, func_free);
+    }
+
+    list->head = list->tail = NULL;
+}
+
+DLNode *dlist_push_back(DList *list, void *data) {
+    DLNode *node;
+
+    node = dlnode_new(list, data);
+    dlist_link(list, list->tail, NULL, node);
+
+    return node;
+}
+
+DLNode *dlist_push_front(DList *list, void *data) {
+    DLNode *node;
+
+    node = dlnode_new(list, data);
+    dlist_link(list, NULL, list->head, node);
+
+    return node;
+}
+
+DLNode *dlist_insert_after(DList *list, DLNode *prev, void *data) {
+    DLNode *node;
+
+    if (!prev)
+        return dlist_push_front(list, data);
+
+    node = dlnode_new(list, data);
+    dlist_link(list, prev, prev->next, node);
+
+    return node;
+}
+
+DLNode *dlist_insert_before(DList *list, DLNode *next, void *data) {
+    DLNode *node;
+
+    if (!next)
+        return dlist_push_back(list, data);
+
+    node = dlnode_new(list, data);
+    dlist_link(list, next->prev, next, node);
+
+    return node;
+}
+
+void *dlist_pop_back(DList *list) {
+    if (!dlist_is_empty(list))
+        return dlist_remove(list, list->tail);
+
+    return NULL;
+}
+
+void *dlist_pop_front(DList *list) {
+    if (!dlist_is_empty(list))
+        return dlist_remove(list, list->head);
+
+    return NULL;
+}
+
+void *dlist_remove(DList *list, DLNode *node) {
+    void *data;
+
+    dlist_unlink(list, node);
+    data = node->data;
+    dlnode_free(list, node, NULL);
+
+    return data;
+}
+
+void dlist_move_front(DList *list, DLNode *node) {
+    if (list->head != node) {
+        dlist_unlink(list, node);
+        dlist_link(list, NULL, list->head, node);
+    }
+}
+
+void dlist_move_back(DList *list, DLNode *node) {
+    if (list->tail != node) {
+        dlist_unlink(list, node);
+        dlist_link(list, list->tail, NULL, node);
+    }
+}
@@ -0,0 +1,181 @@
+/**
+ * @file dlist.h
+ */
+
+#ifndef __DLIST_H__
+#define __DLIST_H__
+
+#include <stdbool.h>
+
+#include "allocator.h"
+#include "llist.h"
+
+/**
+ * @brief doubly linked list's node
+ */
+typedef struct DLNode {
+    void *data;          /**< the node's data */
+    struct DLNode *next; /**< the next node */
+    struct DLNode *prev; /**< the previous node */
+} DLNode;
+
+/**
+ * @brief doubly linked list
+ *
+ * same as LList, but every operation on a node, including the ones at the end, is O(1)
+ */
+typedef struct DList {
+    DLNode *head;     /**< beginning of the list */
+    DLNode *tail;     /**< end of the list */
+    const Allocator *allocator; /**< where the nodes come from, NULL for malloc */
+} DList;
+
+/**
+ * @brief initialize the list
+ *
+ * @param list doubly linked list
+ */
+void dlist_init(DList *list);
+
+/**
+ * @brief initialize the list, using @p allocator for the nodes
+ *
+ * like for LList, the nodes can come from a Pool initialized with pool_init(pool, sizeof(DLNode))
+ *
+ * @param list doubly linked list
+ * @param allocator Allocator, must outlive the list. NULL for malloc
+ */
+void dlist_init_in(DList *list, const Allocator *allocator);
+
+/**
+ * @brief free the list
+ *
+ * won't free the nodes's data, only the list, if @p func_free is NULL
+ *
+ * @param list doubly linked list
+ * @param func_free callback to free the nodes's data
+ */
+void dlist_free(DList *list, Func_Free func_free);
+
+/**
+ * @brief return the node after @p curr
+ *
+ * if @p curr == NULL, returns the first node
+ *
+ * @param list doubly linked list
+ * @param curr current node
+ * @return the next node
+ */
+inline DLNode *dlist_next(DList *list, DLNode *curr) {
+    return curr ? curr->next : list->head;
+}
+
+/**
+ * @brief return the node before @p curr
+ *
+ * if @p curr == NULL, returns the last node
+ *
+ * @param list doubly linked list
+ * @param curr current node
+ * @return the previous node
+ */
+inline DLNode *dlist_prev(DList *list, DLNode *curr) {
+    return curr ? curr->prev : list->tail;
+}
+
+/**
+ * @brief insert node at the end of the list
+ *
+ * @param list doubly linked list
+ * @param data node's data
+ * @return the node inserted
+ */
+DLNode *dlist_push_back(DList *list, void *data);
+
+/**
+ * @brief insert node at the beginning of the list
+ *
+ * @param list doubly linked list
+ * @param data node's data
+ * @return the node inserted
+ */
+DLNode *dlist_push_front(DList *list, void *data);
+
+/**
+ * @brief insert node after @p prev
+ *
+ * if @p prev is NULL, insert at the beginning of the list
+ *
+ * @param list doubly linked list
+ * @param prev node before the one to be inserted
+ * @param data node's data
+ * @return the node inserted
+ */
+DLNode *dlist_insert_after(DList *list, DLNode *prev, void *data);
+
+/**
+ * @brief insert node before @p next
+ *
+ * if @p next is NULL, insert at the end of the list
+ *
+ * @param list doubly linked list
+ * @param next node after the one to be inserted
+ * @param data node's data
+ * @return the node inserted
+ */
+DLNode *dlist_insert_before(DList *list, DLNode *next, void *data);
+
+/**
+ * @brief remove node from the end of the list
+ *
+ * @param list doubly linked list
+ * @return the node's data, NULL if the list is empty
+ */
+void *dlist_pop_back(DList *list);
+
+/**
+ * @brief remove node from the beginning of the list
+ *
+ * @param list doubly linked list
+ * @return the node's data, NULL if the list is empty
+ */
+void *dlist_pop_front(DList *list);
+
+/**
+ * @brief remove @p node from the list
+ *
+ * @param list doubly linked list
+ * @param node node of @p list
+ * @return the node's data
+ */
+void *dlist_remove(DList *list, DLNode *node);
+
+/**
+ * @brief move @p node to the beginning of the list, without reallocating it
+ *
+ * e.g. to mark an entry as the most recently used in an LRU list
+ *
+ * @param list doubly linked list
+ * @param node node of @p list
+ */
+void dlist_move_front(DList *list, DLNode *node);
+
+/**
+ * @brief move @p node to the end of the list, without reallocating it
+ *
+ * @param list doubly linked list
+ * @param node node of @p list
+ */
+void dlist_move_back(DList *list, DLNode *node);
+
+/**
+ * @brief if the list contains data
+ *
+ * @param list doubly linked list
+ * @return boolean
+ */
+inline bool dlist_is_empty(DList *list) {
+    return list->head == (void *)0;
+}
+
+#endif /* __DLIST_H__ */
@@ -1,46 +1,67 @@
 #include "fixed_buffer.h"
 
 #include <stdlib.h>
+#include <string.h>
 
-void fixedbuffer_init(FixedBuffer *fixed_buffer, void *buffer, size_t size) {
-    size_t aligned_head;
+// aligning the addres to a multiple of sizeof(void *)
+static inline char *fb_align(char *ptr) {
+    size_t aligned;
 
-    // aligning the addres to a multiple of sizeof(void *)
-    aligned_head = (size_t)buffer;
-    aligned_head = (aligned_head + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    aligned = (size_t)ptr;
+    aligned = (aligned + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
 
-    fixed_buffer->start = (char *)(aligned_head);
-    fixed_buffer->head = (char *)(aligned_head);
-    fixed_buffer->end = fixed_buffer->start + size;
+    return (char *)aligned;
+}
+
+void fixedbuffer_init(FixedBuffer *fixed_buffer, void *buffer, size_t size) {
+    fixed_buffer->start = fb_align((char *)buffer);
+    fixed_buffer->head = fixed_buffer->start;
+    fixed_buffer->end = (char *)buffer + size;
 }
 
 void *fixedbuffer_alloc(FixedBuffer *fixed_buffer, size_t size) {
-    void *next_head;
+    char *next_head;
+    void *allocation;
 
     next_head = fixed_buffer->head + size;
 
     if (next_head > fixed_buffer->end)
         return NULL;
 
+    allocation = fixed_buffer->head;
+    fixed_buffer->head = fb_align(next_head);
+
+    return allocation;
+}
+
+void *fixedbuffer_realloc(
+    FixedBuffer *fixed_buffer,
+    void *ptr,
+    size_t old_size,
+    size_t new_size
+) {
     void *allocation;
-    size_t aligned_head;
 
-    allocation = fixed_buffer->head;
-    fixed_buffer->head = next_head;
+    if (ptr && fb_align((char *)ptr + old_size) == fixed_buffer->head) {
+        // last allocation, can be resized in place
+        if ((char *)ptr + new_size > fixed_buffer->end)
+            return NULL;
+        fixed_buffer->head = fb_align((char *)ptr + new_size);
+        return ptr;
+    }
 
-    // aligning the addres to a multiple of sizeof(void *)
-    aligned_head = (size_t)fixed_buffer->head;
-    aligned_head = (aligned_head + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
-    fixed_buffer->head = (char *)(aligned_head);
+    allocation = fixedbuffer_alloc(fixed_buffer, new_size);
+    if (allocation && ptr)
+        memcpy(allocation, ptr, old_size < new_size ? old_size : new_size);
 
     return allocation;
 }
 
-void *
-fixedbuffer_realloc(FixedBuffer *fixed_buffer, void *ptr, size_t new_size) {
-    return fixedbuffer_alloc(fixed_buffer, new_size);
+void fixedbuffer_release(FixedBuffer *fixed_buffer, void *ptr, size_t size) {
+    if (ptr && fb_align((char *)ptr + size) == fixed_buffer->head)
+        fixed_buffer->head = (char *)ptr;
 }
 
 void fixedbuffer_clear(FixedBuffer *fixed_buffer) {
     fixed_buffer->head = fixed_buffer->start;
-}
\ No newline at end of file
+}
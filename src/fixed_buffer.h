@@ -1,10 +1,73 @@
+/**
+ * @file fixed_buffer.h
+ */
+
 #ifndef __FIXED_BUFFER_H__
 #define __FIXED_BUFFER_H__
 
+#include <stdlib.h>
+
+/**
+ * @brief bump allocator over a caller-provided buffer
+ */
 typedef struct FixedBuffer {
-    char *start;
-    char *end;
-    char *head;
+    char *start; /**< beginning of the buffer */
+    char *end;   /**< end of the buffer */
+    char *head;  /**< first free byte */
 } FixedBuffer;
 
-#endif /* __FIXED_BUFFER_H__ */
\ No newline at end of file
+/**
+ * @brief initialize the FixedBuffer
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param buffer memory to allocate from
+ * @param size size of @p buffer
+ */
+void fixedbuffer_init(FixedBuffer *fixed_buffer, void *buffer, size_t size);
+
+/**
+ * @brief allocate from the buffer
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param size number of bytes
+ * @return the allocation, or NULL if there isn't enough space
+ */
+void *fixedbuffer_alloc(FixedBuffer *fixed_buffer, size_t size);
+
+/**
+ * @brief resize an allocation
+ *
+ * the last allocation is resized in place, the others are copied into a new one
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param ptr previous allocation, can be NULL
+ * @param old_size size of @p ptr
+ * @param new_size number of bytes
+ * @return the allocation, or NULL if there isn't enough space
+ */
+void *fixedbuffer_realloc(
+    FixedBuffer *fixed_buffer,
+    void *ptr,
+    size_t old_size,
+    size_t new_size
+);
+
+/**
+ * @brief release an allocation
+ *
+ * the space is reclaimed only if @p ptr is the last allocation
+ *
+ * @param fixed_buffer FixedBuffer
+ * @param ptr allocation
+ * @param size size of @p ptr
+ */
+void fixedbuffer_release(FixedBuffer *fixed_buffer, void *ptr, size_t size);
+
+/**
+ * @brief release all the allocations
+ *
+ * @param fixed_buffer FixedBuffer
+ */
+void fixedbuffer_clear(FixedBuffer *fixed_buffer);
+
+#endif /* __FIXED_BUFFER_H__ */
@@ -0,0 +1,134 @@
+#include "hash.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * wyhash, final version 4 (public domain, by Wang Yi), with its default secret.
+ * known answers of the reference implementation, hash_bytes_seeded() must give the same:
+ *
+ *   ""                                   seed 0  0x93228a4de0eec5a2
+ *   "a"                                  seed 1  0xc5bac3db178713c4
+ *   "abc"                                seed 2  0xa97f2f7b1d9b3314
+ *   "message digest"                     seed 3  0x786d1f1df3801df4
+ *   "abcdefghijklmnopqrstuvwxyz"         seed 4  0xdca5a8138ad37c87
+ *   "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+ *   "abcdefghijklmnopqrstuvwxyz"
+ *   "0123456789"                         seed 5  0xb9e734f117cfaf70
+ *   "1234567890" repeated 8 times        seed 6  0x6cc5eab49a92d617
+ */
+
+static const uint64_t secret[4] = {
+    0x2d358dccaa6c78a5ULL,
+    0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL,
+};
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+/* 64x64 -> 128 bit multiplication, low half in a, high half in b */
+static inline void wy_mum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha, hb, la, lb, rh, rm0, rm1, rl, t, c, lo;
+
+    ha = *a >> 32;
+    hb = *b >> 32;
+    la = (uint32_t)*a;
+    lb = (uint32_t)*b;
+    rh = ha * hb;
+    rm0 = ha * lb;
+    rm1 = hb * la;
+    rl = la * lb;
+    t = rl + (rm0 << 32);
+    c = t < rl;
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+    wy_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t wy_r8(const uint8_t *p) {
+    uint64_t v;
+
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t wy_r4(const uint8_t *p) {
+    uint32_t v;
+
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/* 1 to 3 bytes */
+static inline uint64_t wy_r3(const uint8_t *p, size_t k) {
+    return (((uint64_t)p[0]) << 16) | (((uint64_t)p[k >> 1]) << 8) | p[k - 1];
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+uint64_t hash_bytes_seeded(const void *data, size_t len, uint64_t seed) {
+    const uint8_t *p;
+    uint64_t a, b;
+
+    p = data;
+    seed ^= wy_mix(seed ^ secret[0], secret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (wy_r4(p) << 32) | wy_r4(p + ((len >> 3) << 2));
+            b = (wy_r4(p + len - 4) << 32)
+                | wy_r4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = wy_r3(p, len);
+            b = 0;
+        } else
+            a = b = 0;
+    } else {
+        size_t i = len;
+
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+
+            do {
+                seed = wy_mix(wy_r8(p) ^ secret[1], wy_r8(p + 8) ^ seed);
+                see1 = wy_mix(wy_r8(p + 16) ^ secret[2], wy_r8(p + 24) ^ see1);
+                see2 = wy_mix(wy_r8(p + 32) ^ secret[3], wy_r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wy_mix(wy_r8(p) ^ secret[1], wy_r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wy_r8(p + i - 16);
+        b = wy_r8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    wy_mum(&a, &b);
+
+    return wy_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
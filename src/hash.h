@@ -0,0 +1,37 @@
+/**
+ * @file hash.h
+ */
+
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief hash of @p len bytes with a seed
+ *
+ * wyhash: fast, with good distribution, processes 48 bytes per iteration on long inputs.
+ * a secret, random @p seed makes the hashes unpredictable for who doesn't know it,
+ * which protects hash tables fed with untrusted keys from collision attacks.
+ * the result depends on the endianness of the machine
+ *
+ * @param data bytes
+ * @param len number of bytes
+ * @param seed seed
+ * @return hash
+ */
+uint64_t hash_bytes_seeded(const void *data, size_t len, uint64_t seed);
+
+/**
+ * @brief hash of @p len bytes
+ *
+ * @param data bytes
+ * @param len number of bytes
+ * @return hash
+ */
+inline uint64_t hash_bytes(const void *data, size_t len) {
+    return hash_bytes_seeded(data, len, 0);
+}
+
+#endif /* __HASH_H__ */
@@ -0,0 +1,30 @@
+#include "ilist.h"
+
+#include <stddef.h>
+
+void ilist_splice(IList *dest, IList *source) {
+    ILink *first, *last;
+
+    if (ilist_is_empty(source))
+        return;
+
+    first = source->head.next;
+    last = source->head.prev;
+
+    first->prev = dest->head.prev;
+    dest->head.prev->next = first;
+    last->next = &dest->head;
+    dest->head.prev = last;
+
+    ilist_init(source);
+}
+
+size_t ilist_count(IList *list) {
+    ILink *link;
+    size_t n = 0;
+
+    ILIST_FOR_EACH(link, list)
+        n++;
+
+    return n;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file ilist.h
+ */
+
+#ifndef __ILIST_H__
+#define __ILIST_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief link of an intrusive list, to embed in the structs to be listed
+ */
+typedef struct ILink {
+    struct ILink *next; /**< the next link */
+    struct ILink *prev; /**< the previous link */
+} ILink;
+
+/**
+ * @brief intrusive doubly linked list
+ *
+ * the list doesn't allocate anything: it threads together ILink fields embedded in the caller's structs,
+ * which are reached back with ILIST_ENTRY(). a struct can be in as many lists as the ILinks it embeds.
+ * the list is circular around @p head, so no operation has special cases for the ends, and the list
+ * must not be moved in memory while it's not empty
+ */
+typedef struct IList {
+    ILink head; /**< sentinel, its next is the first link and its prev the last */
+} IList;
+
+/**
+ * @brief the struct of type @p type embedding @p link as its member @p member
+ *
+ * @param link ILink *
+ * @param type type of the struct
+ * @param member name of the ILink member
+ */
+#define ILIST_ENTRY(link, type, member) ((type *)((char *)(link) - offsetof(type, member)))
+
+/**
+ * @brief iterate over the links of @p list, from the first
+ *
+ * @p link must not be removed inside the loop, use ILIST_FOR_EACH_SAFE() for that
+ *
+ * @param link ILink * variable
+ * @param list IList *
+ */
+#define ILIST_FOR_EACH(link, list) \
+    for ((link) = (list)->head.next; (link) != &(list)->head; (link) = (link)->next)
+
+/**
+ * @brief iterate over the links of @p list, from the first, allowing to remove @p link
+ *
+ * @param link ILink * variable
+ * @param tmp ILink * variable, used internally
+ * @param list IList *
+ */
+#define ILIST_FOR_EACH_SAFE(link, tmp, list) \
+    for ((link) = (list)->head.next, (tmp) = (link)->next; (link) != &(list)->head; \
+         (link) = (tmp), (tmp) = (link)->next)
+
+/**
+ * @brief initialize the list
+ *
+ * @param list intrusive list
+ */
+inline void ilist_init(IList *list) {
+    list->head.next = list->head.prev = &list->head;
+}
+
+/**
+ * @brief if the list contains links
+ *
+ * @param list intrusive list
+ * @return boolean
+ */
+inline bool ilist_is_empty(IList *list) {
+    return list->head.next == &list->head;
+}
+
+/**
+ * @brief return the link after @p curr
+ *
+ * if @p curr == NULL, returns the first link
+ *
+ * @param list intrusive list
+ * @param curr current link
+ * @return the next link, NULL at the end
+ */
+inline ILink *ilist_next(IList *list, ILink *curr) {
+    ILink *next = curr ? curr->next : list->head.next;
+
+    return next != &list->head ? next : NULL;
+}
+
+/**
+ * @brief return the link before @p curr
+ *
+ * if @p curr == NULL, returns the last link
+ *
+ * @param list intrusive list
+ * @param curr current link
+ * @return the previous link, NULL at the beginning
+ */
+inline ILink *ilist_prev(IList *list, ILink *curr) {
+    ILink *prev = curr ? curr->prev : list->head.prev;
+
+    return prev != &list->head ? prev : NULL;
+}
+
+/**
+ * @brief insert @p link after @p prev
+ *
+ * if @p prev is NULL, insert at the beginning of the list
+ *
+ * @param list intrusive list
+ * @param prev link before the one to be inserted
+ * @param link link to insert, not in any list
+ */
+inline void ilist_insert_after(IList *list, ILink *prev, ILink *link) {
+    if (!prev)
+        prev = &list->head;
+    link->prev = prev;
+    link->next = prev->next;
+    prev->next->prev = link;
+    prev->next = link;
+}
+
+/**
+ * @brief insert @p link before @p next
+ *
+ * if @p next is NULL, insert at the end of the list
+ *
+ * @param list intrusive list
+ * @param next link after the one to be inserted
+ * @param link link to insert, not in any list
+ */
+inline void ilist_insert_before(IList *list, ILink *next, ILink *link) {
+    ilist_insert_after(list, next ? next->prev : list->head.prev, link);
+}
+
+/**
+ * @brief insert @p link at the end of the list
+ *
+ * @param list intrusive list
+ * @param link link to insert, not in any list
+ */
+inline void ilist_push_back(IList *list, ILink *link) {
+    ilist_insert_after(list, list->head.prev, link);
+}
+
+/**
+ * @brief insert @p link at the beginning of the list
+ *
+ * @param list intrusive list
+ * @param link link to insert, not in any list
+ */
+inline void ilist_push_front(IList *list, ILink *link) {
+    ilist_insert_after(list, &list->head, link);
+}
+
+/**
+ * @brief remove @p link from the list it's in
+ *
+ * the list itself isn't needed. the link is left pointing to itself
+ *
+ * @param link link in a list
+ */
+inline void ilist_remove(ILink *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = link->prev = link;
+}
+
+/**
+ * @brief remove the link at the end of the list
+ *
+ * @param list intrusive list
+ * @return the link, NULL if the list is empty
+ */
+inline ILink *ilist_pop_back(IList *list) {
+    ILink *link = list->head.prev;
+
+    if (link == &list->head)
+        return NULL;
+    ilist_remove(link);
+    return link;
+}
+
+/**
+ * @brief remove the link at the beginning of the list
+ *
+ * @param list intrusive list
+ * @return the link, NULL if the list is empty
+ */
+inline ILink *ilist_pop_front(IList *list) {
+    ILink *link = list->head.next;
+
+    if (link == &list->head)
+        return NULL;
+    ilist_remove(link);
+    return link;
+}
+
+/**
+ * @brief move all the links of @p source at the end of @p dest
+ *
+ * @p source is left empty
+ *
+ * @param dest intrusive list
+ * @param source intrusive list
+ */
+void ilist_splice(IList *dest, IList *source);
+
+/**
+ * @brief number of links, walking the whole list
+ *
+ * @param list intrusive list
+ * @return number of links
+ */
+size_t ilist_count(IList *list);
+
+#endif /* __ILIST_H__ */
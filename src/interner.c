@@ -0,0 +1,147 @@
+#include "interner.h"
+#include "hash.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_SIZE (64UL * 1024UL)
+
+/* strings bigger than this get their own allocation, not to waste the rest of a chunk */
+#define BIG_STRING (CHUNK_SIZE / 4)
+
+#define MIN_TABLE_CAP (16UL)
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+/**
+ * @brief find the slot of the string, or the empty slot where it would go
+ *
+ * @param in Interner
+ * @param str characters
+ * @param len number of characters
+ * @param hash hash of the characters
+ * @return index in the table
+ */
+static size_t
+in_probe(Interner *in, const char *str, size_t len, uint64_t hash) {
+    size_t mask, i;
+
+    mask = in->table_cap - 1;
+    for (i = hash & mask; in->table[i]; i = (i + 1) & mask) {
+        uint32_t id = in->table[i] - 1;
+        StrView s = interner_view(in, id);
+
+        if (((uint64_t *)in->hashes.ptr)[id] == hash && s.len == len
+            && memcmp(s.ptr, str, len) == 0)
+            break;
+    }
+
+    return i;
+}
+
+/* keeps the load factor under 1/2 */
+static void in_grow(Interner *in) {
+    uint32_t *old;
+    size_t old_cap, i;
+
+    old = in->table;
+    old_cap = in->table_cap;
+
+    in->table_cap = old_cap ? old_cap * 2 : MIN_TABLE_CAP;
+    in->table = calloc(in->table_cap, sizeof(uint32_t));
+
+    for (i = 0; i < old_cap; i++) {
+        if (old[i]) {
+            uint64_t hash = ((uint64_t *)in->hashes.ptr)[old[i] - 1];
+            size_t mask = in->table_cap - 1, j;
+
+            for (j = hash & mask; in->table[j]; j = (j + 1) & mask)
+                ;
+            in->table[j] = old[i];
+        }
+    }
+
+    free(old);
+}
+
+/* copy of the string, null-terminated */
+static char *in_store(Interner *in, const char *str, size_t len) {
+    char *dst;
+
+    if (len + 1 > BIG_STRING)
+        dst = arena_alloc(&in->arena, len + 1);
+    else {
+        if (in->chunk_used + len + 1 > in->chunk_cap) {
+            in->chunk = arena_alloc(&in->arena, CHUNK_SIZE);
+            in->chunk_cap = CHUNK_SIZE;
+            in->chunk_used = 0;
+        }
+        dst = in->chunk + in->chunk_used;
+        in->chunk_used += len + 1;
+    }
+
+    memcpy(dst, str, len);
+    dst[len] = '\0';
+
+    return dst;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void interner_init(Interner *in) {
+    arena_init(&in->arena);
+    in->chunk = NULL;
+    in->chunk_used = 0;
+    in->chunk_cap = 0;
+    vec_new(&in->strs, sizeof(StrView));
+    vec_new(&in->hashes, sizeof(uint64_t));
+    in->table = NULL;
+    in->table_cap = 0;
+}
+
+void interner_free(Interner *in) {
+    arena_free(&in->arena);
+    vec_free(&in->strs);
+    vec_free(&in->hashes);
+    free(in->table);
+    interner_init(in);
+}
+
+uint32_t interner_intern(Interner *in, const char *str, size_t len) {
+    StrView *s;
+    uint64_t hash;
+    uint32_t id;
+    size_t slot;
+
+    if ((in->strs.len + 1) * 2 > in->table_cap)
+        in_grow(in);
+
+    hash = hash_bytes(str, len);
+    slot = in_probe(in, str, len, hash);
+    if (in->table[slot])
+        return in->table[slot] - 1;
+
+    id = (uint32_t)in->strs.len;
+    s = vec_emplace_back(&in->strs);
+    s->ptr = in_store(in, str, len);
+    s->len = len;
+    vec_push(&in->hashes, &hash);
+    in->table[slot] = id + 1;
+
+    return id;
+}
+
+uint32_t interner_find(Interner *in, const char *str, size_t len) {
+    size_t slot;
+
+    if (!in->table_cap)
+        return INTERNER_NONE;
+
+    slot = in_probe(in, str, len, hash_bytes(str, len));
+    return in->table[slot] ? in->table[slot] - 1 : INTERNER_NONE;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file interner.h
+ */
+
+#ifndef __INTERNER_H__
+#define __INTERNER_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "strview.h"
+#include "vec.h"
+
+/**
+ * @brief returned by interner_find() when the string isn't interned
+ */
+#define INTERNER_NONE ((uint32_t)-1)
+
+/**
+ * @brief pool of unique strings, each identified by a small integer
+ *
+ * the characters are stored contiguously in chunks owned by an Arena and never move,
+ * so the pointers returned stay valid until interner_free(). two strings are equal
+ * if and only if their ids are
+ */
+typedef struct Interner {
+    Arena arena;       /**< owns the chunks */
+    char *chunk;       /**< chunk being filled */
+    size_t chunk_used; /**< bytes used of @p chunk */
+    size_t chunk_cap;  /**< size of @p chunk */
+    Vec strs;          /**< StrView of every string, indexed by id */
+    Vec hashes;        /**< uint64_t hash of every string, indexed by id */
+    uint32_t *table;   /**< open addressing hash table of id + 1, 0 if empty */
+    size_t table_cap;  /**< number of slots of @p table, a power of two */
+} Interner;
+
+/**
+ * @brief initialize the Interner
+ *
+ * @param in Interner
+ */
+void interner_init(Interner *in);
+
+/**
+ * @brief release the Interner and all its strings
+ *
+ * @param in Interner
+ */
+void interner_free(Interner *in);
+
+/**
+ * @brief id of the string, interning it if it's new
+ *
+ * @param in Interner
+ * @param str characters, not necessarily null-terminated
+ * @param len number of characters
+ * @return id, ids are given sequentially from 0
+ */
+uint32_t interner_intern(Interner *in, const char *str, size_t len);
+
+/**
+ * @brief id of the c-style string, interning it if it's new
+ *
+ * @param in Interner
+ * @param str c-style string
+ * @return id
+ */
+inline uint32_t interner_intern_cstr(Interner *in, const char *str) {
+    return interner_intern(in, str, strlen(str));
+}
+
+/**
+ * @brief id of the string if already interned
+ *
+ * @param in Interner
+ * @param str characters, not necessarily null-terminated
+ * @param len number of characters
+ * @return id, or INTERNER_NONE
+ */
+uint32_t interner_find(Interner *in, const char *str, size_t len);
+
+/**
+ * @brief the string with id @p id
+ *
+ * @param in Interner
+ * @param id id returned by interner_intern()
+ * @return view of the string, its characters are followed by a null-terminating character
+ */
+inline StrView interner_view(Interner *in, uint32_t id) {
+    return ((StrView *)in->strs.ptr)[id];
+}
+
+/**
+ * @brief the c-style string with id @p id
+ *
+ * @param in Interner
+ * @param id id returned by interner_intern()
+ * @return c-style string
+ */
+inline const char *interner_str(Interner *in, uint32_t id) {
+    return interner_view(in, id).ptr;
+}
+
+/**
+ * @brief number of unique strings
+ *
+ * @param in Interner
+ * @return number of strings
+ */
+inline size_t interner_count(Interner *in) {
+    return in->strs.len;
+}
+
+#endif /* __INTERNER_H__ */
@@ -0,0 +1,264 @@
+#include "lfqueue.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define NIL (UINT32_MAX)
+
+#define CHUNK_SHIFT (10)
+#define CHUNK_NODES (1UL << CHUNK_SHIFT)
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static inline uint64_t lf_pack(uint32_t idx, uint32_t tag) {
+    return ((uint64_t)tag << 32) | idx;
+}
+
+static inline uint32_t lf_idx(uint64_t tagged) {
+    return (uint32_t)tagged;
+}
+
+static inline uint32_t lf_tag(uint64_t tagged) {
+    return (uint32_t)(tagged >> 32);
+}
+
+/*
+ * the chunk holding a node is published before the node reaches the free list,
+ * so whoever got the index through the queue or the free list sees the chunk too
+ */
+static inline LFNode *lf_node(LFQueue *q, uint32_t idx) {
+    return &q->chunks[idx >> CHUNK_SHIFT][idx & (CHUNK_NODES - 1)];
+}
+
+/* push the chain of free nodes from @p first to @p last */
+static void lf_free_push(LFQueue *q, uint32_t first, uint32_t last) {
+    uint64_t top;
+
+    top = atomic_load_explicit(&q->free, memory_order_relaxed);
+    do
+        atomic_store_explicit(&lf_node(q, last)->free_next, lf_idx(top), memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(
+        &q->free, &top, lf_pack(first, lf_tag(top) + 1), memory_order_release,
+        memory_order_relaxed));
+}
+
+/**
+ * @brief allocate a new chunk, keeping its first node and making the others free
+ *
+ * @param q LFQueue
+ * @return index of the node, NIL if the queue is at its maximum
+ */
+static uint32_t lf_grow(LFQueue *q) {
+    LFNode *chunk;
+    uint32_t base;
+    size_t c, i;
+
+    c = atomic_fetch_add_explicit(&q->nchunks, 1, memory_order_relaxed);
+    if (c >= q->max_chunks)
+        return NIL;
+
+    chunk = malloc(CHUNK_NODES * sizeof(LFNode));
+    base = (uint32_t)(c << CHUNK_SHIFT);
+    for (i = 0; i < CHUNK_NODES; i++) {
+        atomic_init(&chunk[i].next, lf_pack(NIL, 0));
+        atomic_init(&chunk[i].free_next, (uint32_t)(base + i + 1));
+        atomic_init(&chunk[i].data, NULL);
+    }
+    q->chunks[c] = chunk;
+
+    lf_free_push(q, base + 1, (uint32_t)(base + CHUNK_NODES - 1));
+
+    return base;
+}
+
+/**
+ * @brief take a free node, ready to be linked at the end of the queue
+ *
+ * @param q LFQueue
+ * @return index of the node, NIL if the queue is at its maximum
+ */
+static uint32_t lf_alloc(LFQueue *q) {
+    uint64_t top, next;
+    uint32_t idx, succ;
+
+    top = atomic_load_explicit(&q->free, memory_order_acquire);
+    for (;;) {
+        if (lf_idx(top) == NIL) {
+            if ((idx = lf_grow(q)) == NIL)
+                return NIL;
+            break;
+        }
+        // the node can be taken and changed meanwhile, the tag makes the exchange fail then
+        succ = atomic_load_explicit(&lf_node(q, lf_idx(top))->free_next, memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(
+                &q->free, &top, lf_pack(succ, lf_tag(top) + 1), memory_order_acquire,
+                memory_order_acquire)) {
+            idx = lf_idx(top);
+            break;
+        }
+    }
+
+    // a new tag, so whoever still holds the node as the old tail fails to link after it
+    next = atomic_load_explicit(&lf_node(q, idx)->next, memory_order_relaxed);
+    atomic_store_explicit(&lf_node(q, idx)->next, lf_pack(NIL, lf_tag(next) + 1),
+                          memory_order_relaxed);
+
+    return idx;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void lfqueue_init(LFQueue *q, size_t max_nodes) {
+    uint32_t dummy;
+
+    // one more for the dummy node, and NIL is not a valid index
+    if (max_nodes > (size_t)NIL - CHUNK_NODES)
+        max_nodes = (size_t)NIL - CHUNK_NODES;
+    q->max_chunks = (max_nodes + 1 + CHUNK_NODES - 1) >> CHUNK_SHIFT;
+    q->chunks = calloc(q->max_chunks, sizeof(LFNode *));
+    atomic_init(&q->nchunks, 0);
+    atomic_init(&q->free, lf_pack(NIL, 0));
+
+    dummy = lf_alloc(q);
+    atomic_init(&q->head, lf_pack(dummy, 0));
+    atomic_init(&q->tail, lf_pack(dummy, 0));
+}
+
+void lfqueue_free(LFQueue *q) {
+    size_t i, n;
+
+    n = atomic_load(&q->nchunks);
+    if (n > q->max_chunks)
+        n = q->max_chunks;
+    for (i = 0; i < n; i++)
+        free(q->chunks[i]);
+    free(q->chunks);
+    q->chunks = NULL;
+    q->max_chunks = 0;
+    atomic_store(&q->nchunks, 0);
+}
+
+bool lfqueue_push_back(LFQueue *q, void *data) {
+    uint64_t tail, next;
+    uint32_t idx;
+
+    if ((idx = lf_alloc(q)) == NIL)
+        return false;
+    atomic_store_explicit(&lf_node(q, idx)->data, data, memory_order_relaxed);
+
+    for (;;) {
+        tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        next = atomic_load_explicit(&lf_node(q, lf_idx(tail))->next, memory_order_acquire);
+        if (tail != atomic_load_explicit(&q->tail, memory_order_acquire))
+            continue;
+
+        if (lf_idx(next) == NIL) {
+            // publishes data too
+            if (atomic_compare_exchange_weak_explicit(
+                    &lf_node(q, lf_idx(tail))->next, &next, lf_pack(idx, lf_tag(next) + 1),
+                    memory_order_release, memory_order_relaxed))
+                break;
+        } else
+            // the tail is behind, help whoever linked the last node
+            atomic_compare_exchange_weak_explicit(
+                &q->tail, &tail, lf_pack(lf_idx(next), lf_tag(tail) + 1),
+                memory_order_release, memory_order_relaxed);
+    }
+
+    // failing is fine, someone else already moved it
+    atomic_compare_exchange_strong_explicit(
+        &q->tail, &tail, lf_pack(idx, lf_tag(tail) + 1), memory_order_release,
+        memory_order_relaxed);
+
+    return true;
+}
+
+bool lfqueue_pop_front(LFQueue *q, void **data) {
+    uint64_t head, tail, next;
+    void *value;
+
+    for (;;) {
+        head = atomic_load_explicit(&q->head, memory_order_acquire);
+        tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        next = atomic_load_explicit(&lf_node(q, lf_idx(head))->next, memory_order_acquire);
+        if (head != atomic_load_explicit(&q->head, memory_order_acquire))
+            continue;
+
+        if (lf_idx(head) == lf_idx(tail)) {
+            if (lf_idx(next) == NIL)
+                return false;
+            // the tail is behind, move it before the head can pass it
+            atomic_compare_exchange_weak_explicit(
+                &q->tail, &tail, lf_pack(lf_idx(next), lf_tag(tail) + 1),
+                memory_order_release, memory_order_relaxed);
+        } else {
+            // read before the exchange, afterwards the node can be recycled by another consumer
+            value = atomic_load_explicit(&lf_node(q, lf_idx(next))->data, memory_order_relaxed);
+            if (atomic_compare_exchange_weak_explicit(
+                    &q->head, &head, lf_pack(lf_idx(next), lf_tag(head) + 1),
+                    memory_order_acq_rel, memory_order_relaxed))
+                break;
+        }
+    }
+
+    // the next node becomes the dummy, the old dummy is recycled
+    lf_free_push(q, lf_idx(head), lf_idx(head));
+    if (data)
+        *data = value;
+
+    return true;
+}
+
+void mpscqueue_init(MPSCQueue *q) {
+    atomic_init(&q->stub.next, NULL);
+    atomic_init(&q->head, &q->stub);
+    q->tail = &q->stub;
+}
+
+void mpscqueue_push(MPSCQueue *q, MPSCLink *link) {
+    MPSCLink *prev;
+
+    atomic_store_explicit(&link->next, NULL, memory_order_relaxed);
+    prev = atomic_exchange_explicit(&q->head, link, memory_order_acq_rel);
+    // until this store the consumer can't see link, nor anything pushed after it
+    atomic_store_explicit(&prev->next, link, memory_order_release);
+}
+
+MPSCLink *mpscqueue_pop(MPSCQueue *q) {
+    MPSCLink *tail, *next, *head;
+
+    tail = q->tail;
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if (tail == &q->stub) {
+        if (!next)
+            return NULL;
+        q->tail = tail = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+
+    if (next) {
+        q->tail = next;
+        return tail;
+    }
+
+    head = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (tail != head)
+        // a push is halfway through
+        return NULL;
+
+    // tail is the last link: the stub goes after it, so it can be handed out
+    mpscqueue_push(q, &q->stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next) {
+        q->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
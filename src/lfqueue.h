@@ -0,0 +1,139 @@
+/**
+ * @file lfqueue.h
+ *
+ * needs C11 atomics
+ */
+
+#ifndef __LFQUEUE_H__
+#define __LFQUEUE_H__
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @brief node of a LFQueue
+ *
+ * nodes are referred to by index, and their links carry a tag incremented on every change,
+ * so a node recycled while a thread still looks at it can't be mistaken for the old one (ABA)
+ */
+typedef struct LFNode {
+    _Atomic uint64_t next;      /**< tag and index of the next node in the queue */
+    _Atomic uint32_t free_next; /**< index of the next node in the free list */
+    void *_Atomic data;         /**< the node's data */
+} LFNode;
+
+/**
+ * @brief lock-free multi-producer multi-consumer queue
+ *
+ * Michael-Scott queue. the nodes are allocated in chunks that are never released while the queue
+ * lives, and recycled through a lock-free free list, so a thread reading a node that was just
+ * dequeued by another one always reads valid memory, and there's no allocation per element
+ */
+typedef struct LFQueue {
+    _Alignas(64) _Atomic uint64_t head; /**< tag and index of the dummy node before the first */
+    _Alignas(64) _Atomic uint64_t tail; /**< tag and index of the last node, or one before it */
+    _Alignas(64) _Atomic uint64_t free; /**< tag and index of the first free node */
+    _Atomic size_t nchunks;  /**< chunks reserved, can go past @p max_chunks when full */
+    LFNode **chunks;         /**< table of the chunks of nodes */
+    size_t max_chunks;       /**< entries of @p chunks */
+} LFQueue;
+
+/**
+ * @brief initialize the queue
+ *
+ * not thread safe
+ *
+ * @param q LFQueue
+ * @param max_nodes max number of elements in the queue at the same time, rounded up to the chunks of
+ * nodes. the chunks are allocated when needed
+ */
+void lfqueue_init(LFQueue *q, size_t max_nodes);
+
+/**
+ * @brief release the queue and all its nodes
+ *
+ * not thread safe, the elements aren't freed
+ *
+ * @param q LFQueue
+ */
+void lfqueue_free(LFQueue *q);
+
+/**
+ * @brief insert at the end of the queue
+ *
+ * @param q LFQueue
+ * @param data element
+ * @return false if the queue already holds max_nodes elements
+ */
+bool lfqueue_push_back(LFQueue *q, void *data);
+
+/**
+ * @brief remove from the beginning of the queue
+ *
+ * @param q LFQueue
+ * @param data element removed, can be NULL
+ * @return false if the queue was empty
+ */
+bool lfqueue_pop_front(LFQueue *q, void **data);
+
+/**
+ * @brief link of a MPSCQueue, to embed in the structs to be queued
+ */
+typedef struct MPSCLink {
+    struct MPSCLink *_Atomic next; /**< the next link */
+} MPSCLink;
+
+/**
+ * @brief intrusive lock-free multi-producer single-consumer queue
+ *
+ * Vyukov's queue. pushing is a single atomic exchange, wait-free, and nothing is ever allocated:
+ * the queue threads together MPSCLink fields embedded in the caller's structs, reached back with
+ * MPSCQUEUE_ENTRY(). a link returned by mpscqueue_pop() belongs to the consumer again
+ */
+typedef struct MPSCQueue {
+    _Alignas(64) MPSCLink *_Atomic head; /**< last link pushed */
+    _Alignas(64) MPSCLink *tail;         /**< next link to pop, only touched by the consumer */
+    MPSCLink stub;                       /**< placeholder for when the queue is empty */
+} MPSCQueue;
+
+/**
+ * @brief the struct of type @p type embedding @p link as its member @p member
+ *
+ * @param link MPSCLink *
+ * @param type type of the struct
+ * @param member name of the MPSCLink member
+ */
+#define MPSCQUEUE_ENTRY(link, type, member) ((type *)((char *)(link) - offsetof(type, member)))
+
+/**
+ * @brief initialize the queue
+ *
+ * not thread safe. the queue must not be moved in memory afterwards
+ *
+ * @param q MPSCQueue
+ */
+void mpscqueue_init(MPSCQueue *q);
+
+/**
+ * @brief insert at the end of the queue, from any thread
+ *
+ * @param q MPSCQueue
+ * @param link link to insert, not in any queue
+ */
+void mpscqueue_push(MPSCQueue *q, MPSCLink *link);
+
+/**
+ * @brief remove from the beginning of the queue, only from the consumer thread
+ *
+ * can return NULL while a push is halfway through, even if other pushes completed after it:
+ * the consumer is expected to try again later
+ *
+ * @param q MPSCQueue
+ * @return the link, NULL if the queue is empty
+ */
+MPSCLink *mpscqueue_pop(MPSCQueue *q);
+
+#endif /* __LFQUEUE_H__ */
@@ -2,25 +2,32 @@
 
 #include <stdlib.h>
 
-static LLNode *llnode_new(void *data) {
+static LLNode *llnode_new(LList *list, void *data) {
     LLNode *node;
 
-    node = malloc(sizeof(LLNode));
+    node = allocator_alloc(list->allocator, sizeof(LLNode));
     node->data = data;
     node->next = NULL;
 
     return node;
 }
 
-static inline void llnode_free(LLNode *node, Func_Free func_free) {
+static inline void
+llnode_free(LList *list, LLNode *node, Func_Free func_free) {
     if (func_free)
         func_free(node->data);
-    free(node);
+    allocator_free(list->allocator, node, sizeof(LLNode));
 }
 
 void llist_init(LList *list) {
     list->head = NULL;
     list->tail = NULL;
+    list->allocator = NULL;
+}
+
+void llist_init_in(LList *list, const Allocator *allocator) {
+    llist_init(list);
+    list->allocator = allocator;
 }
 
 void llist_free(LList *list, Func_Free func_free) {
@@ -33,10 +40,10 @@ void llist_free(LList *list, Func_Free func_free) {
         while (next) {
             curr = next;
             next = next->next;
-            llnode_free(curr, func_free);
+            llnode_free(list, curr, func_free);
         }
 
-        llnode_free(list->head, func_free);
+        llnode_free(list, list->head, func_free);
         list->head = list->tail = NULL;
     }
 }
@@ -62,7 +69,7 @@ LLNode *llist_prev(LList *list, LLNode *curr) {
 LLNode *llist_push_back(LList *list, void *data) {
     LLNode *node;
 
-    node = llnode_new(data);
+    node = llnode_new(list, data);
 
     if (!llist_is_empty(list)) {
         list->tail->next = node;
@@ -76,7 +83,7 @@ LLNode *llist_push_back(LList *list, void *data) {
 LLNode *llist_push_front(LList *list, void *data) {
     LLNode *node;
 
-    node = llnode_new(data);
+    node = llnode_new(list, data);
 
     if (!llist_is_empty(list)) {
         node->next = list->head;
@@ -91,7 +98,7 @@ LLNode *llist_insert(LList *list, LLNode *prev, void *data) {
     if (prev) {
         LLNode *node;
 
-        node = llnode_new(data);
+        node = llnode_new(list, data);
         node->next = prev->next;
         prev->next = node;
 
@@ -119,7 +126,7 @@ void *llist_pop_back(LList *list) {
             }
         }
 
-        llnode_free(to_remove, NULL);
+        llnode_free(list, to_remove, NULL);
 
         return data;
     }
@@ -140,7 +147,7 @@ void *llist_pop_front(LList *list) {
         else
             list->head = list->head->next;
 
-        llnode_free(to_remove, NULL);
+        llnode_free(list, to_remove, NULL);
 
         return data;
     }
@@ -156,11 +163,11 @@ void *llist_remove(LList *list, LLNode *node) {
         if (list->head == node) {
             list->head = node->next;
             data = node->data;
-            llnode_free(node, NULL);
+            llnode_free(list, node, NULL);
         } else if ((prev = llist_prev(list, node)) != NULL) {
             prev->next = node->next;
             data = node->data;
-            llnode_free(node, NULL);
+            llnode_free(list, node, NULL);
         } else
             data = NULL;
 
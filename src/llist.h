@@ -7,6 +7,8 @@
 
 #include <stdbool.h>
 
+#include "allocator.h"
+
 /**
  * @brief linked list's node
  */
@@ -26,6 +28,7 @@ typedef void (*Func_Free)(void *);
 typedef struct LList {
     LLNode *head;     /**< beginning of the list */
     LLNode *tail;     /**< end of the list */
+    const Allocator *allocator; /**< where the nodes come from, NULL for malloc */
 } LList;
 
 /**
@@ -35,10 +38,24 @@ typedef struct LList {
  */
 void llist_init(LList *list);
 
+/**
+ * @brief initialize the list, using @p allocator for the nodes
+ *
+ * a Pool initialized with pool_init(pool, sizeof(LLNode)) and passed through allocator_from_pool()
+ * hands out the nodes from big blocks and recycles them, without calling malloc for each one.
+ * it can be shared by more lists
+ *
+ * @param list linked list
+ * @param allocator Allocator, must outlive the list. NULL for malloc
+ */
+void llist_init_in(LList *list, const Allocator *allocator);
+
 /**
  * @brief free the list
  * 
- * won't free the nodes's data, only the list, if @p func_free is NULL
+ * won't free the nodes's data, only the list, if @p func_free is NULL.
+ * a list whose Pool isn't shared can instead be dropped at once with pool_free(),
+ * without visiting the nodes, and initialized again
  * 
  * @param list linked list
  * @param func_free callback to free the nodes's data
@@ -0,0 +1,87 @@
+#include "pool.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* a block is about this big, unless the objects are so big it'd hold too few */
+#define BLOCK_SIZE (64UL * 1024UL)
+
+#define MIN_PER_BLOCK (16UL)
+
+/* keeps the first slot aligned like malloc()'s */
+#define HEADER_SIZE (16UL)
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static bool pool_grow(Pool *pool) {
+    PoolBlock *block;
+
+    if ((block = malloc(HEADER_SIZE + pool->szof * pool->nper_block)) == NULL)
+        return false;
+    block->next = pool->blocks;
+    pool->blocks = block;
+
+    // slots are handed out in order, so a fresh block isn't walked to build a free list
+    pool->bump = (char *)block + HEADER_SIZE;
+    pool->bump_end = pool->bump + pool->szof * pool->nper_block;
+
+    return true;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void pool_init(Pool *pool, size_t szof) {
+    // every slot must be able to hold the link of the free list
+    if (szof < sizeof(void *))
+        szof = sizeof(void *);
+    szof = (szof + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+    pool->szof = szof;
+    pool->nper_block = (BLOCK_SIZE - HEADER_SIZE) / szof;
+    if (pool->nper_block < MIN_PER_BLOCK)
+        pool->nper_block = MIN_PER_BLOCK;
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_end = NULL;
+    pool->blocks = NULL;
+}
+
+void *pool_alloc(Pool *pool) {
+    void *ptr;
+
+    if (pool->free_list) {
+        ptr = pool->free_list;
+        pool->free_list = *(void **)ptr;
+        return ptr;
+    }
+
+    if (pool->bump == pool->bump_end && !pool_grow(pool))
+        return NULL;
+    ptr = pool->bump;
+    pool->bump += pool->szof;
+
+    return ptr;
+}
+
+void pool_release(Pool *pool, void *ptr) {
+    *(void **)ptr = pool->free_list;
+    pool->free_list = ptr;
+}
+
+void pool_free(Pool *pool) {
+    PoolBlock *curr, *next;
+
+    for (curr = pool->blocks; curr; curr = next) {
+        next = curr->next;
+        free(curr);
+    }
+
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_end = NULL;
+    pool->blocks = NULL;
+}
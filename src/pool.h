@@ -0,0 +1,69 @@
+/**
+ * @file pool.h
+ */
+
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stdlib.h>
+
+/**
+ * @brief header of every block allocated by the Pool
+ */
+typedef struct PoolBlock {
+    struct PoolBlock *next; /**< previous block */
+} PoolBlock;
+
+/**
+ * @brief allocator of objects of a single size
+ *
+ * objects are carved out of big blocks, released objects are reused before carving new ones.
+ * allocating and releasing are a few instructions, without ever calling malloc for a single object
+ */
+typedef struct Pool {
+    size_t szof;       /**< size of a slot */
+    size_t nper_block; /**< slots per block */
+    void *free_list;   /**< released slots, each one holds the pointer to the next */
+    char *bump;        /**< first slot never used of the last block */
+    char *bump_end;    /**< end of the last block */
+    PoolBlock *blocks; /**< last block */
+} Pool;
+
+/**
+ * @brief initialize the Pool
+ *
+ * no memory is allocated until the first object
+ *
+ * @param pool Pool
+ * @param szof size of the objects
+ */
+void pool_init(Pool *pool, size_t szof);
+
+/**
+ * @brief allocate an object
+ *
+ * the object is aligned like malloc()'s if @p szof is a multiple of 16, to the pointer size otherwise
+ *
+ * @param pool Pool
+ * @return the object, uninitialized, or NULL if a new block couldn't be allocated
+ */
+void *pool_alloc(Pool *pool);
+
+/**
+ * @brief give an object back to the Pool, for the next pool_alloc()
+ *
+ * @param pool Pool
+ * @param ptr object allocated by @p pool
+ */
+void pool_release(Pool *pool, void *ptr);
+
+/**
+ * @brief release all the objects and the blocks
+ *
+ * the Pool can still be used afterwards
+ *
+ * @param pool Pool
+ */
+void pool_free(Pool *pool);
+
+#endif /* __POOL_H__ */
@@ -0,0 +1,105 @@
+#include "rope.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+/* owned fragments are read when needed, since a SStr stored inline moves with the Vec */
+static inline const char *frag_ptr(RopeFrag *frag) {
+    return frag->ptr ? frag->ptr : sstr_data(&frag->owned);
+}
+
+static inline size_t frag_len(RopeFrag *frag) {
+    return frag->ptr ? frag->len : frag->owned.len;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void rope_init(Rope *rope) {
+    rope_init_in(rope, NULL);
+}
+
+void rope_init_in(Rope *rope, const Allocator *allocator) {
+    vec_new_in(&rope->frags, sizeof(RopeFrag), allocator);
+    rope->len = 0;
+}
+
+void rope_free(Rope *rope) {
+    size_t i;
+
+    for (i = 0; i < rope->frags.len; i++) {
+        RopeFrag *frag = vec_elem_at(&rope->frags, i);
+
+        if (!frag->ptr)
+            sstr_free(&frag->owned);
+    }
+    vec_free(&rope->frags);
+    rope->len = 0;
+}
+
+void rope_add(Rope *rope, const char *ptr, size_t len) {
+    RopeFrag *frag;
+
+    if (!len)
+        return;
+
+    frag = vec_emplace_back(&rope->frags);
+    frag->ptr = ptr;
+    frag->len = len;
+    rope->len += len;
+}
+
+void rope_add_cstr(Rope *rope, const char *str) {
+    rope_add(rope, str, strlen(str));
+}
+
+void rope_add_sstr(Rope *rope, SStr *s) {
+    RopeFrag *frag;
+
+    if (s->len) {
+        frag = vec_emplace_back(&rope->frags);
+        frag->ptr = NULL;
+        frag->len = 0;
+        frag->owned = *s;
+        rope->len += s->len;
+    } else
+        sstr_free(s);
+
+    sstr_new_in(s, s->allocator);
+}
+
+char *rope_flatten(Rope *rope, SStr *dest) {
+    size_t i;
+
+    sstr_reserve(dest, dest->len + rope->len);
+    for (i = 0; i < rope->frags.len; i++) {
+        RopeFrag *frag = vec_elem_at(&rope->frags, i);
+
+        sstr_cat_n(dest, frag_ptr(frag), frag_len(frag));
+    }
+
+    return sstr_data(dest);
+}
+
+void rope_iovec(Rope *rope, Vec *iov) {
+    struct iovec *vecs;
+    size_t i;
+
+    vec_truncate(iov);
+    if (!rope->frags.len)
+        return;
+
+    vecs = vec_push_uninit_n(iov, rope->frags.len);
+    for (i = 0; i < rope->frags.len; i++) {
+        RopeFrag *frag = vec_elem_at(&rope->frags, i);
+
+        vecs[i].iov_base = (void *)frag_ptr(frag);
+        vecs[i].iov_len = frag_len(frag);
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file rope.h
+ */
+
+#ifndef __ROPE_H__
+#define __ROPE_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+#include "sstr.h"
+#include "vec.h"
+
+/**
+ * @brief fragment of a Rope
+ */
+typedef struct RopeFrag {
+    const char *ptr; /**< borrowed characters, NULL if owned */
+    size_t len;      /**< number of borrowed characters */
+    SStr owned;      /**< owned characters, if @p ptr is NULL */
+} RopeFrag;
+
+/**
+ * @brief string assembled from fragments, without copying them
+ *
+ * the fragments are only copied once, when flattened. otherwise they can be written out as they are
+ */
+typedef struct Rope {
+    Vec frags;  /**< RopeFrag */
+    size_t len; /**< total number of characters */
+} Rope;
+
+/**
+ * @brief initialize the Rope
+ *
+ * @param rope Rope
+ */
+void rope_init(Rope *rope);
+
+/**
+ * @brief initialize the Rope, using @p allocator for its memory
+ *
+ * @param rope Rope
+ * @param allocator Allocator, must outlive the Rope. NULL for malloc
+ */
+void rope_init_in(Rope *rope, const Allocator *allocator);
+
+/**
+ * @brief release the Rope and the fragments it owns
+ *
+ * @param rope Rope
+ */
+void rope_free(Rope *rope);
+
+/**
+ * @brief append borrowed characters
+ *
+ * @p ptr isn't copied, it must stay valid and unchanged as long as the Rope uses it
+ *
+ * @param rope Rope
+ * @param ptr characters
+ * @param len number of characters
+ */
+void rope_add(Rope *rope, const char *ptr, size_t len);
+
+/**
+ * @brief append a borrowed c-style string
+ *
+ * @param rope Rope
+ * @param str c-style string, must outlive the Rope
+ */
+void rope_add_cstr(Rope *rope, const char *str);
+
+/**
+ * @brief append a SStr, taking ownership of it
+ *
+ * @p s is left empty, its memory is released by rope_free()
+ *
+ * @param rope Rope
+ * @param s SStr
+ */
+void rope_add_sstr(Rope *rope, SStr *s);
+
+/**
+ * @brief total number of characters
+ *
+ * @param rope Rope
+ * @return length
+ */
+inline size_t rope_len(Rope *rope) {
+    return rope->len;
+}
+
+/**
+ * @brief append all the fragments to @p dest
+ *
+ * @p dest is reallocated at most once
+ *
+ * @param rope Rope
+ * @param dest SStr
+ * @return the underlying c-style string of @p dest
+ */
+char *rope_flatten(Rope *rope, SStr *dest);
+
+/**
+ * @brief the fragments as struct iovec, e.g. for writev()
+ *
+ * @p iov is overwritten. it's valid until the Rope is modified
+ *
+ * @param rope Rope
+ * @param iov Vec of struct iovec, initialized by the caller
+ */
+void rope_iovec(Rope *rope, Vec *iov);
+
+#endif /* __ROPE_H__ */
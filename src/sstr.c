@@ -1,27 +1,86 @@
 #include "sstr.h"
+#include "hash.h"
 
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define GROWTH_FACTOR (2UL)
 
+/* enough for the digits of a 64 bit integer and the sign */
+#define INT_DIGITS_MAX (24)
+
+/* more decimals than this go through printf */
+#define DOUBLE_PRECISION_MAX (18)
+
+/* 2^53, past it doubles don't hold every integer, so the digits would be wrong */
+#define DOUBLE_EXACT_MAX (9007199254740992.0)
+
+static const char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 /********************************************************************************************
  *                                     PRIVATE METHODS                                      *
  ********************************************************************************************/
 
+/* capacity in bytes, null-terminating character included */
+static inline size_t s_cap(SStr *s) {
+    return sstr_capacity(s) + 1;
+}
+
+/* heap capacities are kept even, see SStr */
+static inline void s_set_heap(SStr *s, char *ptr, size_t nbytes) {
+    s->u.heap.ptr = ptr;
+    s->u.heap.cap = ~nbytes;
+}
+
+static inline void s_set_inline(SStr *s) {
+    s->u.inl[SSTR_INLINE_CAP] = '\0';
+}
+
 inline static void s_alloc(SStr *s, size_t nbytes) {
-    s->ptr = malloc(nbytes);
-    s->cap = nbytes;
+    char *ptr;
+
+    ptr = allocator_alloc(s->allocator, nbytes);
+    memcpy(ptr, s->u.inl, s->len + 1);
+    s_set_heap(s, ptr, nbytes);
 }
 
 inline static void s_realloc(SStr *s, size_t nbytes) {
-    s->ptr = realloc(s->ptr, nbytes);
-    s->cap = nbytes;
+    s_set_heap(
+        s,
+        allocator_realloc(s->allocator, s->u.heap.ptr, s_cap(s), nbytes),
+        nbytes
+    );
+}
+
+/* move back inline, the string must fit */
+inline static void s_dealloc(SStr *s) {
+    char *ptr;
+    size_t nbytes;
+
+    ptr = s->u.heap.ptr;
+    nbytes = s_cap(s);
+    memcpy(s->u.inl, ptr, s->len + 1);
+    s_set_inline(s);
+    allocator_free(s->allocator, ptr, nbytes);
 }
 
 /**
  * @brief resize SStr.
  * 
+ * if fits inline, move back inline
  * if shrink, realloc by exact number
  * if grow  , realloc by GROWTH_FACTOR when possible, otherwise exact number
  * 
@@ -29,14 +88,53 @@ inline static void s_realloc(SStr *s, size_t nbytes) {
  * @param nbytes number of bytes required
  */
 static void sstr_resize(SStr *s, size_t nbytes) {
-    if (s->cap) {
-        if (nbytes < s->cap || nbytes > s->cap * GROWTH_FACTOR)
-            s_realloc(s, nbytes);
-        else if (nbytes > s->cap)
-            s_realloc(s, s->cap * GROWTH_FACTOR);
-    } else {
-        s_alloc(s, nbytes > GROWTH_FACTOR ? nbytes : GROWTH_FACTOR);
+    size_t cap;
+
+    if (nbytes <= SSTR_INLINE_CAP + 1) {
+        if (!sstr_is_inline(s))
+            s_dealloc(s);
+        return;
+    }
+
+    cap = s_cap(s);
+    if (nbytes < cap || nbytes > cap * GROWTH_FACTOR)
+        cap = nbytes;
+    else if (nbytes > cap)
+        cap *= GROWTH_FACTOR;
+    else
+        return;
+    cap += cap & 1;
+
+    if (sstr_is_inline(s))
+        s_alloc(s, cap);
+    else
+        s_realloc(s, cap);
+}
+
+/**
+ * @brief write @p val in base 10, backwards from @p end
+ *
+ * @param end one past the last digit
+ * @param val value
+ * @return first digit
+ */
+static char *s_utoa(char *end, unsigned long long val) {
+    while (val >= 100) {
+        const char *pair = digit_pairs + (val % 100) * 2;
+
+        val /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
     }
+    if (val >= 10) {
+        const char *pair = digit_pairs + val * 2;
+
+        *--end = pair[1];
+        *--end = pair[0];
+    } else
+        *--end = (char)('0' + val);
+
+    return end;
 }
 
 /********************************************************************************************
@@ -44,14 +142,21 @@ static void sstr_resize(SStr *s, size_t nbytes) {
  ********************************************************************************************/
 
 void sstr_new(SStr *s) {
-    s->cap = 0;
+    s->u.inl[0] = '\0';
+    s_set_inline(s);
     s->len = 0;
+    s->allocator = NULL;
+    sstr_invalidate_hash(s);
+}
+
+void sstr_new_in(SStr *s, const Allocator *allocator) {
+    sstr_new(s);
+    s->allocator = allocator;
 }
 
 void sstr_new_with(SStr *s, size_t len) {
     sstr_new(s);
     sstr_reserve(s, len);
-    sstr_cpy(s, "");
 }
 
 void sstr_from(SStr *s, const char *source) {
@@ -60,61 +165,242 @@ void sstr_from(SStr *s, const char *source) {
 }
 
 void sstr_free(SStr *s) {
-    if (s->cap)
-        free(s->ptr);
-    s->cap = 0;
+    if (!sstr_is_inline(s))
+        allocator_free(s->allocator, s->u.heap.ptr, s_cap(s));
+    s->u.inl[0] = '\0';
+    s_set_inline(s);
     s->len = 0;
+    sstr_invalidate_hash(s);
 }
 
 void sstr_reserve(SStr *s, size_t len) {
-    if (len + 1 > s->cap)
+    if (len + 1 > s_cap(s))
         sstr_resize(s, len + 1);
 }
 
 void sstr_shrink_to_fit(SStr *s) {
-    if (s->cap > s->len + 1)
+    if (s_cap(s) > s->len + 1)
         sstr_resize(s, s->len + 1);
 }
 
 char *sstr_cpy(SStr *dest, const char *source) {
-    dest->len = strlen(source);
-    sstr_reserve(dest, dest->len);
-    return strcpy(dest->ptr, source);
+    size_t len;
+
+    len = strlen(source);
+    sstr_reserve(dest, len);
+    dest->len = len;
+    sstr_invalidate_hash(dest);
+    return memcpy(sstr_data(dest), source, len + 1);
 }
 
 char *sstr_ncpy(SStr *dest, const char *source, size_t num) {
-    dest->len = strlen(source);
-    if (dest->len > num)
-        dest->len = num;
-    sstr_reserve(dest, dest->len);
-    dest->ptr[dest->len] = '\0';
-    return strncpy(dest->ptr, source, dest->len);
+    size_t len;
+    char *data;
+
+    len = strlen(source);
+    if (len > num)
+        len = num;
+    sstr_reserve(dest, len);
+    dest->len = len;
+    sstr_invalidate_hash(dest);
+    data = sstr_data(dest);
+    data[len] = '\0';
+    return memcpy(data, source, len);
 }
 
 char *sstr_cat(SStr *dest, const char *source) {
-    dest->len += strlen(source);
-    sstr_reserve(dest, dest->len);
-    return strcat(dest->ptr, source);
+    return sstr_cat_n(dest, source, strlen(source));
 }
 
 char *sstr_ncat(SStr *dest, const char *source, size_t num) {
-    size_t len_src;
+    const char *end;
 
-    len_src = strlen(source);
-    if (len_src < num)
-        num = len_src;
-    dest->len += num;
-    sstr_reserve(dest, dest->len);
-    dest->ptr[dest->len] = '\0';
-    return strncat(dest->ptr, source, num);
+    if ((end = memchr(source, '\0', num)) != NULL)
+        num = end - source;
+    return sstr_cat_n(dest, source, num);
+}
+
+char *sstr_cat_n(SStr *dest, const char *buf, size_t len) {
+    char *data;
+
+    sstr_reserve(dest, dest->len + len);
+    data = sstr_data(dest);
+    memcpy(data + dest->len, buf, len);
+    dest->len += len;
+    data[dest->len] = '\0';
+    sstr_invalidate_hash(dest);
+
+    return data;
+}
+
+char *sstr_cat_sstr(SStr *dest, SStr *source) {
+    char *data;
+    size_t len;
+
+    // source can be dest, so its data is taken after reserving
+    len = source->len;
+    sstr_reserve(dest, dest->len + len);
+    data = sstr_data(dest);
+    memcpy(data + dest->len, sstr_data(source), len);
+    dest->len += len;
+    data[dest->len] = '\0';
+    sstr_invalidate_hash(dest);
+
+    return data;
+}
+
+char *sstr_join(SStr *dest, SStr *pieces, size_t n, const char *sep) {
+    size_t len_sep, len, i;
+
+    if (!n)
+        return sstr_data(dest);
+
+    len_sep = strlen(sep);
+    len = dest->len + (n - 1) * len_sep;
+    for (i = 0; i < n; i++)
+        len += pieces[i].len;
+    sstr_reserve(dest, len);
+
+    sstr_cat_sstr(dest, &pieces[0]);
+    for (i = 1; i < n; i++) {
+        sstr_cat_n(dest, sep, len_sep);
+        sstr_cat_sstr(dest, &pieces[i]);
+    }
+
+    return sstr_data(dest);
+}
+
+char *sstr_catf(SStr *dest, const char *format, ...) {
+    va_list ap;
+    char *data;
+
+    va_start(ap, format);
+    data = sstr_vcatf(dest, format, ap);
+    va_end(ap);
+
+    return data;
+}
+
+char *sstr_vcatf(SStr *dest, const char *format, va_list ap) {
+    va_list retry;
+    size_t avail;
+    char *data;
+    int len;
+
+    va_copy(retry, ap);
+
+    avail = sstr_capacity(dest) - dest->len;
+    data = sstr_data(dest);
+    len = vsnprintf(data + dest->len, avail + 1, format, ap);
+
+    if (len < 0) {
+        data[dest->len] = '\0';
+    } else {
+        if ((size_t)len > avail) {
+            sstr_reserve(dest, dest->len + len);
+            data = sstr_data(dest);
+            vsnprintf(data + dest->len, (size_t)len + 1, format, retry);
+        }
+        dest->len += len;
+        sstr_invalidate_hash(dest);
+    }
+
+    va_end(retry);
+
+    return data;
+}
+
+char *sstr_cat_int(SStr *dest, long long val) {
+    char buf[INT_DIGITS_MAX], *start;
+
+    // negating in unsigned arithmetic is fine for LLONG_MIN too
+    if (val < 0) {
+        start = s_utoa(buf + sizeof(buf), 0ULL - (unsigned long long)val);
+        *--start = '-';
+    } else
+        start = s_utoa(buf + sizeof(buf), (unsigned long long)val);
+
+    return sstr_cat_n(dest, start, buf + sizeof(buf) - start);
+}
+
+char *sstr_cat_uint(SStr *dest, unsigned long long val) {
+    char buf[INT_DIGITS_MAX], *start;
+
+    start = s_utoa(buf + sizeof(buf), val);
+
+    return sstr_cat_n(dest, start, buf + sizeof(buf) - start);
+}
+
+char *sstr_cat_double(SStr *dest, double val, int precision) {
+    static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+    };
+    char buf[INT_DIGITS_MAX + 2], *start, *end;
+    unsigned long long scaled, ipart, fpart;
+    double abs_val, scale, product;
+    int i;
+
+    if (val != val)
+        return sstr_cat_n(dest, "nan", 3);
+
+    if (precision < 0)
+        precision = 6;
+
+    if (precision > DOUBLE_PRECISION_MAX)
+        return sstr_catf(dest, "%.*f", precision, val);
+
+    abs_val = signbit(val) ? -val : val;
+    scale = pow10[precision];
+    product = abs_val * scale;
+    if (product + 1.0 >= DOUBLE_EXACT_MAX)
+        // inf ends up here too
+        return sstr_catf(dest, "%.*f", precision, val);
+
+    // halves to even, like printf
+    scaled = (unsigned long long)product;
+    product -= (double)scaled;
+    if (product > 0.5 || (product == 0.5 && (scaled & 1)))
+        scaled++;
+    ipart = scaled / (unsigned long long)scale;
+    fpart = scaled % (unsigned long long)scale;
+
+    end = buf + sizeof(buf);
+    start = end;
+    if (precision) {
+        for (i = 0; i < precision; i++) {
+            *--start = (char)('0' + fpart % 10);
+            fpart /= 10;
+        }
+        *--start = '.';
+    }
+    start = s_utoa(start, ipart);
+    // -0.0 too
+    if (signbit(val))
+        *--start = '-';
+
+    return sstr_cat_n(dest, start, end - start);
 }
 
 char *sstr_merge(SStr *dest, SStr *source, const char *sep) {
     if (source->len) {
-        dest->len += source->len + strlen(sep);
-        sstr_reserve(dest, dest->len);
-        strcat(strcat(dest->ptr, sep), source->ptr);
+        size_t len_sep;
+
+        len_sep = strlen(sep);
+        sstr_reserve(dest, dest->len + len_sep + source->len);
+        sstr_cat_n(dest, sep, len_sep);
+        sstr_cat_sstr(dest, source);
     }
     sstr_free(source);
-    return dest->ptr;
-}
\ No newline at end of file
+    return sstr_data(dest);
+}
+
+uint64_t sstr_hash(SStr *s) {
+    if (!s->hash)
+        s->hash = hash_bytes(sstr_data(s), s->len);
+    return s->hash;
+}
+
+uint64_t sstr_hash_seeded(SStr *s, uint64_t seed) {
+    return hash_bytes_seeded(sstr_data(s), s->len, seed);
+}
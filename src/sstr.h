@@ -5,31 +5,63 @@
 #ifndef __SSTR_H__
 #define __SSTR_H__
 
+#include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
+#include "allocator.h"
+
+/**
+ * @brief max length of a string stored inline, without allocating
+ */
+#define SSTR_INLINE_CAP (sizeof(char *) + sizeof(size_t) - 1)
+
 /**
  * @brief Dynamic string
+ *
+ * short strings are stored inline, in the bytes that would otherwise hold the pointer and the capacity.
+ * the last of those bytes tells the two modes apart: inline it's always '\0' (it's the terminator of
+ * the longest inline string), on the heap it belongs to the capacity, which is stored complemented
+ * and is always even, so that byte is never 0 whatever the endianness.
+ * sstr_hash() is cached, every sstr_* call that modifies the string clears the cache
  */
 typedef struct SStr {
-    char *ptr;  /**< underlying c-style string (access through sstr_data()) */
-    size_t cap; /**< capacity allocated */
+    union {
+        struct {
+            char *ptr;  /**< underlying c-style string */
+            size_t cap; /**< ~capacity allocated */
+        } heap;
+        char inl[SSTR_INLINE_CAP + 1]; /**< underlying c-style string, if short */
+    } u; /**< storage (access through sstr_data()) */
     size_t len; /**< length of the SStr */
+    const Allocator *allocator; /**< where the memory comes from, NULL for malloc */
+    uint64_t hash; /**< cached sstr_hash(), 0 if not computed yet */
 } SStr;
 
 /**
  * @brief new SStr
  *
- * the SStr is not allocated, therefore sstr_data() returns NULL
+ * the SStr is empty and not allocated
  *
  * @param s SStr
  */
 void sstr_new(SStr *s);
 
+/**
+ * @brief new SStr using @p allocator for its memory
+ *
+ * the SStr is empty and not allocated
+ *
+ * @param s SStr
+ * @param allocator Allocator, must outlive the SStr. NULL for malloc
+ */
+void sstr_new_in(SStr *s, const Allocator *allocator);
+
 /**
  * @brief new SStr with reserved space
  *
- * the SStr has 0 length but is allocated, therefore sstr_data() is valid
+ * the SStr has 0 length, and is allocated if @p len doesn't fit inline
  *
  * @param s SStr
  * @param len minimum number of characters to reserve memory for
@@ -47,10 +79,57 @@ void sstr_from(SStr *s, const char *source);
 /**
  * @brief release memory
  *
+ * the SStr is left empty
+ *
  * @param s SStr
  */
 void sstr_free(SStr *s);
 
+/**
+ * @brief forget the cached hash
+ *
+ * the sstr_* functions already do it, call it after writing through sstr_data()
+ *
+ * @param s SStr
+ */
+inline void sstr_invalidate_hash(SStr *s) {
+    s->hash = 0;
+}
+
+/**
+ * @brief if the string is stored inline, without allocations
+ *
+ * @param s SStr
+ * @return boolean
+ */
+inline bool sstr_is_inline(const SStr *s) {
+    return s->u.inl[SSTR_INLINE_CAP] == '\0';
+}
+
+/**
+ * @brief number of characters that fit without reallocating
+ *
+ * @param s SStr
+ * @return capacity, excluding the null-terminating character
+ */
+inline size_t sstr_capacity(const SStr *s) {
+    if (sstr_is_inline(s))
+        return SSTR_INLINE_CAP;
+    return ~s->u.heap.cap - 1;
+}
+
+/**
+ * @brief return the underlying c-style string
+ *
+ * @param s SStr
+ * @return c-style string
+ */
+inline char *sstr_data(SStr *s) {
+    if (sstr_is_inline(s))
+        return s->u.inl;
+    return s->u.heap.ptr;
+}
+
 /**
  * @brief empty the string but don't free the memory, so it can be reused
  *
@@ -58,8 +137,9 @@ void sstr_free(SStr *s);
  */
 inline void sstr_truncate(SStr *s) {
     if (s->len) {
-        *s->ptr = '\0';
+        *sstr_data(s) = '\0';
         s->len = 0;
+        sstr_invalidate_hash(s);
     }
 }
 
@@ -74,21 +154,11 @@ void sstr_reserve(SStr *s, size_t len);
 /**
  * @brief shrink allocated memory to what is exactly needed for length
  *
- * @param s SStr
- */
-void sstr_shrink_to_fit(SStr *s);
-
-/**
- * @brief return the underlying c-style string, or NULL
+ * if the string fits inline, the memory is released
  *
  * @param s SStr
- * @return c-style string or NULL
  */
-inline char *sstr_data(SStr *s) {
-    if (s->cap)  // len could be 0, but still allocated because of the null-terminating character
-        return s->ptr;
-    return NULL;
-}
+void sstr_shrink_to_fit(SStr *s);
 
 /**
  * @brief return the underlying c-style string starting at @p pos, or NULL
@@ -98,9 +168,9 @@ inline char *sstr_data(SStr *s) {
  * @return c-style string or NULL
  */
 inline char *sstr_data_from(SStr *s, size_t pos) {
-    // asking for the position from the null-terminating char is valid, so i hate to check s->cap too
-    if (pos <= s->len && s->cap)
-        return s->ptr + pos;
+    // asking for the position from the null-terminating char is valid
+    if (pos <= s->len)
+        return sstr_data(s) + pos;
     return NULL;
 }
 
@@ -142,6 +212,114 @@ char *sstr_cat(SStr *dest, const char *source);
  */
 char *sstr_ncat(SStr *dest, const char *source, size_t num);
 
+/**
+ * @brief append @p len bytes of @p buf
+ *
+ * writes right after the current length, without scanning either string
+ *
+ * @param dest SStr
+ * @param buf source bytes, not necessarily null-terminated
+ * @param len number of bytes to append
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_cat_n(SStr *dest, const char *buf, size_t len);
+
+/**
+ * @brief append @p source to @p dest
+ *
+ * @p source can be @p dest itself
+ *
+ * @param dest SStr
+ * @param source SStr
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_cat_sstr(SStr *dest, SStr *source);
+
+/**
+ * @brief append a character
+ *
+ * @param dest SStr
+ * @param c character
+ */
+inline void sstr_push_char(SStr *dest, char c) {
+    char *data;
+
+    if (dest->len == sstr_capacity(dest))
+        sstr_reserve(dest, dest->len + 1);
+    data = sstr_data(dest);
+    data[dest->len++] = c;
+    data[dest->len] = '\0';
+    sstr_invalidate_hash(dest);
+}
+
+/**
+ * @brief append @p n SStr with c-style string @p sep in between
+ *
+ * the total length is measured first, so @p dest is reallocated at most once
+ *
+ * @param dest SStr
+ * @param pieces array of SStr
+ * @param n number of elements of @p pieces
+ * @param sep separator
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_join(SStr *dest, SStr *pieces, size_t n, const char *sep);
+
+/**
+ * @brief sprintf appending to @p dest
+ *
+ * formats straight into the spare capacity, and only if it doesn't fit reserves once and formats again
+ *
+ * @param dest SStr
+ * @param format printf format
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_catf(SStr *dest, const char *format, ...);
+
+/**
+ * @brief vsprintf appending to @p dest
+ *
+ * @param dest SStr
+ * @param format printf format
+ * @param ap arguments
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_vcatf(SStr *dest, const char *format, va_list ap);
+
+/**
+ * @brief append a signed integer in base 10, without going through printf
+ *
+ * @param dest SStr
+ * @param val value
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_cat_int(SStr *dest, long long val);
+
+/**
+ * @brief append an unsigned integer in base 10, without going through printf
+ *
+ * @param dest SStr
+ * @param val value
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_cat_uint(SStr *dest, unsigned long long val);
+
+/**
+ * @brief append a floating point number with @p precision decimals, like "%.*f"
+ *
+ * doesn't go through printf when the value scaled by 10^@p precision stays below 2^53, where the digits
+ * are exact, the others fall back to it. halves are rounded to even like printf does, but the value is
+ * scaled in double arithmetic, so when it's within a rounding error of a half the last digit can differ
+ * from printf's, which rounds the exact binary value (e.g. 2.675 with 2 decimals is "2.68" here, "2.67"
+ * for printf)
+ *
+ * @param dest SStr
+ * @param val value
+ * @param precision number of decimals
+ * @return the underlying c-style string of @p dest
+ */
+char *sstr_cat_double(SStr *dest, double val, int precision);
+
 /**
  * @brief merge two SStr
  *
@@ -153,6 +331,27 @@ char *sstr_ncat(SStr *dest, const char *source, size_t num);
  */
 char *sstr_merge(SStr *dest, SStr *source, const char *sep);
 
+/**
+ * @brief hash of the content
+ *
+ * see hash_bytes(). it's computed once and reused until the SStr is modified
+ *
+ * @param s SStr
+ * @return hash
+ */
+uint64_t sstr_hash(SStr *s);
+
+/**
+ * @brief hash of the content with a seed, never cached
+ *
+ * see hash_bytes_seeded()
+ *
+ * @param s SStr
+ * @param seed seed
+ * @return hash
+ */
+uint64_t sstr_hash_seeded(SStr *s, uint64_t seed);
+
 /**
  * @brief if SStr is empty
  *
@@ -0,0 +1,177 @@
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE /* posix_fadvise() */
+#endif
+
+#include "sstr_io.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* big enough to make the syscalls negligible, small enough to stay in L2 */
+#define READER_BUF_SIZE (256UL * 1024UL)
+
+/* growth of the SStr when the size of the file isn't known */
+#define READ_CHUNK (64UL * 1024UL)
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+/**
+ * @brief read(), retrying when interrupted
+ *
+ * @return number of bytes read, 0 at end of file, -1 on failure
+ */
+static ssize_t io_read(int fd, char *buf, size_t nbytes) {
+    ssize_t n;
+
+    do
+        n = read(fd, buf, nbytes);
+    while (n < 0 && errno == EINTR);
+
+    return n;
+}
+
+/**
+ * @brief refill the buffer, which must be fully consumed
+ *
+ * @param r SStrReader
+ * @return number of bytes read, 0 at end of file, -1 on failure
+ */
+static ssize_t reader_fill(SStrReader *r) {
+    ssize_t n;
+
+    n = io_read(r->fd, r->buf, READER_BUF_SIZE);
+    r->pos = 0;
+    r->end = n > 0 ? (size_t)n : 0;
+
+    return n;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+int sstr_reader_open(SStrReader *r, const char *path) {
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return -1;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    // more aggressive readahead
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    sstr_reader_from_fd(r, fd);
+    r->owned = true;
+
+    return 0;
+}
+
+void sstr_reader_from_fd(SStrReader *r, int fd) {
+    r->fd = fd;
+    r->owned = false;
+    r->buf = malloc(READER_BUF_SIZE);
+    r->pos = 0;
+    r->end = 0;
+}
+
+int sstr_reader_close(SStrReader *r) {
+    int ret = 0;
+
+    if (r->owned)
+        ret = close(r->fd);
+    free(r->buf);
+    r->fd = -1;
+    r->owned = false;
+    r->buf = NULL;
+    r->pos = 0;
+    r->end = 0;
+
+    return ret;
+}
+
+int sstr_getline(SStr *s, SStrReader *r) {
+    const char *start, *nl;
+    size_t avail;
+    ssize_t n;
+
+    sstr_truncate(s);
+
+    for (;;) {
+        if (r->pos == r->end) {
+            if ((n = reader_fill(r)) < 0)
+                return -1;
+            if (n == 0)
+                // a last line without '\n' was read in the previous iterations
+                return s->len ? 1 : 0;
+        }
+
+        start = r->buf + r->pos;
+        avail = r->end - r->pos;
+        if ((nl = memchr(start, '\n', avail)) != NULL) {
+            sstr_cat_n(s, start, nl - start);
+            r->pos += nl - start + 1;
+            return 1;
+        }
+
+        // the line continues in the next read
+        sstr_cat_n(s, start, avail);
+        r->pos = r->end;
+    }
+}
+
+int sstr_read_file(SStr *s, const char *path) {
+    struct stat st;
+    size_t len;
+    ssize_t n;
+    char *data;
+    int fd, err;
+
+    sstr_truncate(s);
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return -1;
+
+    // one more byte, so the read that finds the end of the file doesn't need to grow it
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        sstr_reserve(s, (size_t)st.st_size + 1);
+
+    // files in /proc and pipes report no size, or a wrong one, so read until the end regardless
+    len = 0;
+    for (;;) {
+        if (len == sstr_capacity(s)) {
+            // what was read so far must be part of the string, or it's not carried over
+            data = sstr_data(s);
+            data[len] = '\0';
+            s->len = len;
+            sstr_reserve(s, len + READ_CHUNK);
+        }
+        data = sstr_data(s);
+        if ((n = io_read(fd, data + len, sstr_capacity(s) - len)) <= 0)
+            break;
+        len += (size_t)n;
+    }
+
+    data[len] = '\0';
+    s->len = len;
+    sstr_invalidate_hash(s);
+
+    if (n < 0) {
+        err = errno;
+        close(fd);
+        sstr_truncate(s);
+        errno = err;
+        return -1;
+    }
+
+    // nothing was written, so there's nothing to report
+    close(fd);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file sstr_io.h
+ */
+
+#ifndef __SSTR_IO_H__
+#define __SSTR_IO_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "sstr.h"
+
+/**
+ * @brief buffered reader of a file descriptor, for sstr_getline()
+ */
+typedef struct SStrReader {
+    int fd;     /**< file descriptor */
+    bool owned; /**< if the fd is closed by sstr_reader_close() */
+    char *buf;  /**< read buffer */
+    size_t pos; /**< first byte of @p buf not consumed yet */
+    size_t end; /**< one past the last byte read into @p buf */
+} SStrReader;
+
+/**
+ * @brief open @p path for reading
+ *
+ * @param r SStrReader
+ * @param path path of the file
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int sstr_reader_open(SStrReader *r, const char *path);
+
+/**
+ * @brief read from an already open file descriptor
+ *
+ * @p fd is not closed by sstr_reader_close()
+ *
+ * @param r SStrReader
+ * @param fd file descriptor
+ */
+void sstr_reader_from_fd(SStrReader *r, int fd);
+
+/**
+ * @brief release the buffer, and close the file if it was opened by sstr_reader_open()
+ *
+ * @param r SStrReader
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int sstr_reader_close(SStrReader *r);
+
+/**
+ * @brief read the next line into @p s, replacing its content
+ *
+ * the line is copied from the read buffer straight into @p s, whose capacity is reused, so once
+ * it's grown to the longest line there are no more allocations. there's no limit on the length.
+ * the '\n' is dropped, a '\r' before it is not. the last line doesn't need a '\n'
+ *
+ * @param s SStr
+ * @param r SStrReader
+ * @return 1 if a line was read, 0 at end of file, -1 on failure (errno is set)
+ */
+int sstr_getline(SStr *s, SStrReader *r);
+
+/**
+ * @brief read the whole file at @p path into @p s, replacing its content
+ *
+ * regular files are measured first, so @p s is allocated once and the bytes are read straight into it.
+ * the content isn't checked for '\0'
+ *
+ * @param s SStr
+ * @param path path of the file
+ * @return 0 on success, -1 on failure (errno is set, @p s is left empty)
+ */
+int sstr_read_file(SStr *s, const char *path);
+
+#endif /* __SSTR_IO_H__ */
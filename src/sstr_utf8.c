@@ -0,0 +1,427 @@
+#include "sstr_utf8.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define U8_X86
+    #include <immintrin.h>
+    #define U8_SSSE3 __attribute__((target("ssse3")))
+    #define U8_AVX2  __attribute__((target("avx2")))
+#endif
+
+#define HIGH_BITS (0x8080808080808080ULL)
+
+/* below this the vector validators don't pay for their setup */
+#define SIMD_MIN_LEN (16)
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static inline uint64_t u8_load64(const unsigned char *p) {
+    uint64_t w;
+
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+static inline unsigned u8_popcount64(uint64_t w) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (unsigned)((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static inline bool u8_is_cont(unsigned char c) {
+    return (c & 0xC0) == 0x80;
+}
+
+static bool u8_validate_scalar(const unsigned char *p, size_t len) {
+    unsigned char c, b;
+    size_t i;
+
+    i = 0;
+    while (i < len) {
+        c = p[i];
+
+        if (c < 0x80) {
+            i++;
+            while (i + 8 <= len && !(u8_load64(p + i) & HIGH_BITS))
+                i += 8;
+        } else if (c >= 0xC2 && c <= 0xDF) {
+            if (len - i < 2 || !u8_is_cont(p[i + 1]))
+                return false;
+            i += 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            if (len - i < 3)
+                return false;
+            b = p[i + 1];
+            // overlong and surrogates
+            if ((c == 0xE0 && b < 0xA0) || (c == 0xED && b > 0x9F))
+                return false;
+            if (!u8_is_cont(b) || !u8_is_cont(p[i + 2]))
+                return false;
+            i += 3;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            if (len - i < 4)
+                return false;
+            b = p[i + 1];
+            // overlong and past U+10FFFF
+            if ((c == 0xF0 && b < 0x90) || (c == 0xF4 && b > 0x8F))
+                return false;
+            if (!u8_is_cont(b) || !u8_is_cont(p[i + 2]) || !u8_is_cont(p[i + 3]))
+                return false;
+            i += 4;
+        } else
+            return false;
+    }
+
+    return true;
+}
+
+#ifdef U8_X86
+
+/*
+ * vector validation by lookup tables (Keiser, Lemire: "Validating UTF-8 In Less Than One Instruction
+ * Per Byte"). every pair of consecutive bytes is classified by three 16 entry tables, indexed by the
+ * high and low nibble of the first and the high nibble of the second. each bit of an entry is an error
+ * that's possible given that nibble, and an error happened if it's possible for all three.
+ * continuations expected as third or fourth byte are checked apart, against the bytes 2 and 3 before
+ */
+
+    #define TOO_SHORT   (1 << 0) /* 11______ 0_______, 11______ 11______ */
+    #define TOO_LONG    (1 << 1) /* 0_______ 10______ */
+    #define OVERLONG_3  (1 << 2) /* 11100000 100_____ */
+    #define TOO_LARGE   (1 << 3) /* 11110100 1001____, 11110100 101_____, 11110101+ */
+    #define SURROGATE   (1 << 4) /* 11101101 101_____ */
+    #define OVERLONG_2  (1 << 5) /* 1100000_ 10______ */
+    #define TOO_LARGE_1000 (1 << 6) /* 11110101+ 1000____ */
+    #define OVERLONG_4  (1 << 6) /* 11110000 1000____ */
+    #define TWO_CONTS   (1 << 7) /* 10______ 10______ */
+    #define CARRY       (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+static const unsigned char byte_1_high[16] = {
+    // 0_______ ________
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    // 10______ ________
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    // 1100____ ________
+    TOO_SHORT | OVERLONG_2,
+    // 1101____ ________
+    TOO_SHORT,
+    // 1110____ ________
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    // 1111____ ________
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+
+static const unsigned char byte_1_low[16] = {
+    // ____0000 ________
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    // ____0001 ________
+    CARRY | OVERLONG_2,
+    // ____001_ ________
+    CARRY,
+    CARRY,
+    // ____0100 ________
+    CARRY | TOO_LARGE,
+    // ____0101 ________ and up
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    // ____1101 ________
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+
+static const unsigned char byte_2_high[16] = {
+    // ________ 0_______
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    // ________ 1000____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    // ________ 1001____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    // ________ 101_____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    // ________ 11______
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+};
+
+/* a block ending with these needs continuations from the next one */
+static const unsigned char max_last[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+/* errors of @p input, given the block before it */
+static inline U8_SSSE3 __m128i u8_check_ssse3(__m128i input, __m128i prev_input) {
+    const __m128i lo4 = _mm_set1_epi8(0x0F);
+    __m128i prev1, prev2, prev3, sc, must23;
+
+    prev1 = _mm_alignr_epi8(input, prev_input, 15);
+    sc = _mm_and_si128(
+        _mm_and_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)byte_1_high),
+                             _mm_and_si128(_mm_srli_epi16(prev1, 4), lo4)),
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)byte_1_low),
+                             _mm_and_si128(prev1, lo4))),
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)byte_2_high),
+                         _mm_and_si128(_mm_srli_epi16(input, 4), lo4)));
+
+    prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    prev3 = _mm_alignr_epi8(input, prev_input, 13);
+    must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80))),
+                          _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80))));
+    must23 = _mm_and_si128(must23, _mm_set1_epi8((char)0x80));
+
+    return _mm_xor_si128(must23, sc);
+}
+
+static U8_SSSE3 bool u8_validate_ssse3(const unsigned char *p, size_t len) {
+    __m128i input, prev, err, incomplete, max;
+    unsigned char tail[16];
+    size_t i;
+
+    max = _mm_loadu_si128((const __m128i *)(max_last + 16));
+    prev = err = incomplete = _mm_setzero_si128();
+
+    for (i = 0; i < len; i += 16) {
+        if (len - i >= 16)
+            input = _mm_loadu_si128((const __m128i *)(p + i));
+        else {
+            // padded with ASCII, so a truncated sequence at the end is an error
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, p + i, len - i);
+            input = _mm_loadu_si128((const __m128i *)tail);
+        }
+
+        if (!_mm_movemask_epi8(input))
+            err = _mm_or_si128(err, incomplete);
+        else {
+            err = _mm_or_si128(err, u8_check_ssse3(input, prev));
+            incomplete = _mm_subs_epu8(input, max);
+        }
+        prev = input;
+    }
+    err = _mm_or_si128(err, incomplete);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(err, _mm_setzero_si128())) == 0xFFFF;
+}
+
+/* errors of @p input, given the block before it */
+static inline U8_AVX2 __m256i u8_check_avx2(__m256i input, __m256i prev_input) {
+    const __m256i lo4 = _mm256_set1_epi8(0x0F);
+    __m256i carried, prev1, prev2, prev3, sc, must23;
+
+    // the last 16 bytes of prev_input followed by the first 16 of input
+    carried = _mm256_permute2x128_si256(prev_input, input, 0x21);
+    prev1 = _mm256_alignr_epi8(input, carried, 15);
+    sc = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte_1_high)),
+                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lo4)),
+            _mm256_shuffle_epi8(
+                _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte_1_low)),
+                _mm256_and_si256(prev1, lo4))),
+        _mm256_shuffle_epi8(
+            _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte_2_high)),
+            _mm256_and_si256(_mm256_srli_epi16(input, 4), lo4)));
+
+    prev2 = _mm256_alignr_epi8(input, carried, 14);
+    prev3 = _mm256_alignr_epi8(input, carried, 13);
+    must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80))),
+                             _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80))));
+    must23 = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+
+    return _mm256_xor_si256(must23, sc);
+}
+
+static U8_AVX2 bool u8_validate_avx2(const unsigned char *p, size_t len) {
+    __m256i input, prev, err, incomplete, max;
+    unsigned char tail[32];
+    size_t i;
+
+    max = _mm256_loadu_si256((const __m256i *)max_last);
+    prev = err = incomplete = _mm256_setzero_si256();
+
+    for (i = 0; i < len; i += 32) {
+        if (len - i >= 32)
+            input = _mm256_loadu_si256((const __m256i *)(p + i));
+        else {
+            // padded with ASCII, so a truncated sequence at the end is an error
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, p + i, len - i);
+            input = _mm256_loadu_si256((const __m256i *)tail);
+        }
+
+        if (!_mm256_movemask_epi8(input))
+            err = _mm256_or_si256(err, incomplete);
+        else {
+            err = _mm256_or_si256(err, u8_check_avx2(input, prev));
+            incomplete = _mm256_subs_epu8(input, max);
+        }
+        prev = input;
+    }
+    err = _mm256_or_si256(err, incomplete);
+
+    return _mm256_testz_si256(err, err);
+}
+
+#endif /* U8_X86 */
+
+/* bytes needed to encode @p cp, 0 if it's not a valid codepoint */
+static inline size_t u8_cp_len(uint32_t cp) {
+    if (cp < 0x80)
+        return 1;
+    if (cp < 0x800)
+        return 2;
+    if (cp < 0x10000)
+        return (cp >= 0xD800 && cp <= 0xDFFF) ? 0 : 3;
+    if (cp <= 0x10FFFF)
+        return 4;
+    return 0;
+}
+
+/* write @p cp, of @p nbytes bytes, at @p out */
+static inline char *u8_encode(char *out, uint32_t cp, size_t nbytes) {
+    switch (nbytes) {
+    case 1:
+        *out++ = (char)cp;
+        break;
+    case 2:
+        *out++ = (char)(0xC0 | (cp >> 6));
+        *out++ = (char)(0x80 | (cp & 0x3F));
+        break;
+    case 3:
+        *out++ = (char)(0xE0 | (cp >> 12));
+        *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (cp & 0x3F));
+        break;
+    default:
+        *out++ = (char)(0xF0 | (cp >> 18));
+        *out++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+        *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (cp & 0x3F));
+        break;
+    }
+
+    return out;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+bool utf8_validate(const char *buf, size_t len) {
+    const unsigned char *p = (const unsigned char *)buf;
+
+#ifdef U8_X86
+    if (len >= SIMD_MIN_LEN) {
+        if (__builtin_cpu_supports("avx2"))
+            return u8_validate_avx2(p, len);
+        if (__builtin_cpu_supports("ssse3"))
+            return u8_validate_ssse3(p, len);
+    }
+#endif
+
+    return u8_validate_scalar(p, len);
+}
+
+size_t utf8_count(const char *buf, size_t len) {
+    const unsigned char *p = (const unsigned char *)buf;
+    size_t i, conts;
+    uint64_t w;
+
+    // every byte is a codepoint, except continuations (10xxxxxx)
+    conts = 0;
+    for (i = 0; i + 8 <= len; i += 8) {
+        w = u8_load64(p + i);
+        conts += u8_popcount64(w & ~(w << 1) & HIGH_BITS);
+    }
+    for (; i < len; i++)
+        conts += u8_is_cont(p[i]);
+
+    return len - conts;
+}
+
+bool sstr_from_checked(SStr *s, const char *buf, size_t len) {
+    sstr_new(s);
+    if (!utf8_validate(buf, len))
+        return false;
+    sstr_cat_n(s, buf, len);
+    return true;
+}
+
+bool sstr_cat_codepoint(SStr *dest, uint32_t cp) {
+    char buf[4];
+    size_t nbytes;
+
+    if (!(nbytes = u8_cp_len(cp)))
+        return false;
+    u8_encode(buf, cp, nbytes);
+    sstr_cat_n(dest, buf, nbytes);
+    return true;
+}
+
+bool sstr_cat_utf16(SStr *dest, const uint16_t *src, size_t len) {
+    size_t nbytes, i;
+    uint32_t cp;
+    char *data, *out;
+
+    // measure and validate, so dest is touched only if everything can be converted
+    nbytes = 0;
+    for (i = 0; i < len; i++) {
+        cp = src[i];
+        if (cp < 0x80)
+            nbytes += 1;
+        else if (cp < 0x800)
+            nbytes += 2;
+        else if (cp < 0xD800 || cp > 0xDFFF)
+            nbytes += 3;
+        else if (cp <= 0xDBFF && i + 1 < len && src[i + 1] >= 0xDC00 && src[i + 1] <= 0xDFFF) {
+            nbytes += 4;
+            i++;
+        } else
+            return false;
+    }
+
+    sstr_reserve(dest, dest->len + nbytes);
+    data = sstr_data(dest);
+    out = data + dest->len;
+    for (i = 0; i < len; i++) {
+        cp = src[i];
+        if (cp < 0x80) {
+            *out++ = (char)cp;
+            continue;
+        }
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (src[i + 1] - 0xDC00);
+            i++;
+        }
+        out = u8_encode(out, cp, u8_cp_len(cp));
+    }
+
+    dest->len += nbytes;
+    data[dest->len] = '\0';
+    sstr_invalidate_hash(dest);
+
+    return true;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file sstr_utf8.h
+ */
+
+#ifndef __SSTR_UTF8_H__
+#define __SSTR_UTF8_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "sstr.h"
+
+/**
+ * @brief if @p len bytes of @p buf are valid UTF-8
+ *
+ * overlong encodings, surrogates and codepoints past U+10FFFF are rejected.
+ * on x86 the CPU is checked at runtime, and the AVX2 or SSSE3 validator is used when available,
+ * 32 or 16 bytes at a time, otherwise a scalar one that skips ASCII 8 bytes at a time
+ *
+ * @param buf bytes
+ * @param len number of bytes
+ * @return boolean
+ */
+bool utf8_validate(const char *buf, size_t len);
+
+/**
+ * @brief number of codepoints in @p len bytes of valid UTF-8
+ *
+ * @param buf bytes
+ * @param len number of bytes
+ * @return number of codepoints
+ */
+size_t utf8_count(const char *buf, size_t len);
+
+/**
+ * @brief if @p s is valid UTF-8
+ *
+ * @param s SStr
+ * @return boolean
+ */
+inline bool sstr_validate_utf8(SStr *s) {
+    return utf8_validate(sstr_data(s), s->len);
+}
+
+/**
+ * @brief number of codepoints of @p s, which must be valid UTF-8
+ *
+ * @param s SStr
+ * @return number of codepoints
+ */
+inline size_t sstr_count_codepoints(SStr *s) {
+    return utf8_count(sstr_data(s), s->len);
+}
+
+/**
+ * @brief new SStr from @p len bytes of @p buf, only if they're valid UTF-8
+ *
+ * @param s SStr
+ * @param buf bytes
+ * @param len number of bytes
+ * @return true on success, false if @p buf isn't valid UTF-8 (@p s is empty)
+ */
+bool sstr_from_checked(SStr *s, const char *buf, size_t len);
+
+/**
+ * @brief append a codepoint encoded in UTF-8
+ *
+ * @param dest SStr
+ * @param cp codepoint
+ * @return true on success, false if @p cp is a surrogate or past U+10FFFF (@p dest is unchanged)
+ */
+bool sstr_cat_codepoint(SStr *dest, uint32_t cp);
+
+/**
+ * @brief append @p len UTF-16 code units, transcoded to UTF-8
+ *
+ * the output length is measured first, so @p dest is reallocated at most once
+ *
+ * @param dest SStr
+ * @param src UTF-16 code units, in native byte order
+ * @param len number of code units
+ * @return true on success, false on an unpaired surrogate (@p dest is unchanged)
+ */
+bool sstr_cat_utf16(SStr *dest, const uint16_t *src, size_t len);
+
+#endif /* __SSTR_UTF8_H__ */
@@ -0,0 +1,84 @@
+#include "strtable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec_sort.h"
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static int st_cmp(const void *a, const void *b) {
+    return strview_cmp(*(const StrView *)a, *(const StrView *)b);
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void strtable_new(StrTable *t) {
+    strtable_new_in(t, NULL);
+}
+
+void strtable_new_in(StrTable *t, const Allocator *allocator) {
+    vec_new_in(&t->bytes, sizeof(char), allocator);
+    vec_new_in(&t->offsets, sizeof(size_t), allocator);
+}
+
+void strtable_free(StrTable *t) {
+    vec_free(&t->bytes);
+    vec_free(&t->offsets);
+}
+
+void strtable_reserve(StrTable *t, size_t nstrs, size_t nbytes) {
+    // every string has its '\0'
+    vec_reserve(&t->bytes, nbytes + nstrs);
+    vec_reserve(&t->offsets, nstrs);
+}
+
+size_t strtable_push(StrTable *t, const char *str, size_t len) {
+    size_t *offset;
+    char *dst;
+
+    offset = vec_emplace_back(&t->offsets);
+    *offset = t->bytes.len;
+    dst = vec_push_uninit_n(&t->bytes, len + 1);
+    memcpy(dst, str, len);
+    dst[len] = '\0';
+
+    return t->offsets.len - 1;
+}
+
+void strtable_sort(StrTable *t) {
+    Vec views, bytes;
+    StrView *view;
+    size_t *offsets;
+    size_t i, n;
+    char *dst;
+
+    n = t->offsets.len;
+    if (n < 2)
+        return;
+
+    // the lengths come from the neighbouring offsets, so they're taken before sorting
+    vec_new_in(&views, sizeof(StrView), t->offsets.allocator);
+    view = vec_push_uninit_n(&views, n);
+    for (i = 0; i < n; i++)
+        view[i] = strtable_view(t, i);
+    vec_sort(&views, st_cmp);
+
+    vec_new_in(&bytes, sizeof(char), t->bytes.allocator);
+    dst = vec_push_uninit_n(&bytes, t->bytes.len);
+    view = views.ptr;
+    offsets = t->offsets.ptr;
+    for (i = 0; i < n; i++) {
+        offsets[i] = dst - (char *)bytes.ptr;
+        memcpy(dst, view[i].ptr, view[i].len + 1);
+        dst += view[i].len + 1;
+    }
+
+    vec_free(&views);
+    vec_free(&t->bytes);
+    t->bytes = bytes;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file strtable.h
+ */
+
+#ifndef __STRTABLE_H__
+#define __STRTABLE_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "strview.h"
+#include "vec.h"
+
+/**
+ * @brief list of strings stored back to back in a single buffer
+ *
+ * each string costs its bytes, its '\0' and one offset, instead of an allocation of its own.
+ * appending can move the buffer, so pointers returned by strtable_get() are valid until the next change
+ */
+typedef struct StrTable {
+    Vec bytes;   /**< char, the strings, each one null-terminated */
+    Vec offsets; /**< size_t, where each string starts in @p bytes */
+} StrTable;
+
+/**
+ * @brief new StrTable
+ *
+ * @param t StrTable
+ */
+void strtable_new(StrTable *t);
+
+/**
+ * @brief new StrTable using @p allocator for its memory
+ *
+ * @param t StrTable
+ * @param allocator Allocator, must outlive the StrTable. NULL for malloc
+ */
+void strtable_new_in(StrTable *t, const Allocator *allocator);
+
+/**
+ * @brief release the memory of all the strings at once
+ *
+ * @param t StrTable
+ */
+void strtable_free(StrTable *t);
+
+/**
+ * @brief remove all the strings but keep the memory, so it can be reused
+ *
+ * @param t StrTable
+ */
+inline void strtable_truncate(StrTable *t) {
+    vec_truncate(&t->bytes);
+    vec_truncate(&t->offsets);
+}
+
+/**
+ * @brief reserve memory ahead of time
+ *
+ * @param t StrTable
+ * @param nstrs minimum number of strings
+ * @param nbytes minimum number of characters, of all the strings together
+ */
+void strtable_reserve(StrTable *t, size_t nstrs, size_t nbytes);
+
+/**
+ * @brief number of strings
+ *
+ * @param t StrTable
+ * @return number of strings
+ */
+inline size_t strtable_count(StrTable *t) {
+    return t->offsets.len;
+}
+
+/**
+ * @brief append @p len bytes of @p str as a new string
+ *
+ * @param t StrTable
+ * @param str characters, not necessarily null-terminated
+ * @param len number of characters
+ * @return index of the new string
+ */
+size_t strtable_push(StrTable *t, const char *str, size_t len);
+
+/**
+ * @brief append a c-style string
+ *
+ * @param t StrTable
+ * @param str c-style string
+ * @return index of the new string
+ */
+inline size_t strtable_push_cstr(StrTable *t, const char *str) {
+    return strtable_push(t, str, strlen(str));
+}
+
+/**
+ * @brief c-style string at index @p pos
+ *
+ * @param t StrTable
+ * @param pos index, must be less than strtable_count()
+ * @return c-style string, valid until the StrTable is modified
+ */
+inline const char *strtable_get(StrTable *t, size_t pos) {
+    return (const char *)t->bytes.ptr + ((size_t *)t->offsets.ptr)[pos];
+}
+
+/**
+ * @brief length of the string at index @p pos
+ *
+ * @param t StrTable
+ * @param pos index, must be less than strtable_count()
+ * @return number of characters
+ */
+inline size_t strtable_len(StrTable *t, size_t pos) {
+    size_t *offsets = t->offsets.ptr;
+    size_t end;
+
+    end = pos + 1 < t->offsets.len ? offsets[pos + 1] : t->bytes.len;
+    return end - offsets[pos] - 1;
+}
+
+/**
+ * @brief StrView of the string at index @p pos
+ *
+ * @param t StrTable
+ * @param pos index, must be less than strtable_count()
+ * @return StrView, valid until the StrTable is modified
+ */
+inline StrView strtable_view(StrTable *t, size_t pos) {
+    return strview_from(strtable_get(t, pos), strtable_len(t, pos));
+}
+
+/**
+ * @brief sort the strings by content, byte by byte like memcmp()
+ *
+ * the buffer is rebuilt in the new order, so scanning the sorted table still reads memory sequentially.
+ * needs a scratch buffer as big as the StrTable
+ *
+ * @param t StrTable
+ */
+void strtable_sort(StrTable *t);
+
+#endif /* __STRTABLE_H__ */
@@ -0,0 +1,195 @@
+#include "strview.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+/* index of the lowest bit set, mask != 0 */
+static inline unsigned sv_ctz(unsigned mask) {
+    #if defined(__GNUC__)
+    return (unsigned)__builtin_ctz(mask);
+    #else
+    unsigned i;
+
+    for (i = 0; !(mask & 1); i++)
+        mask >>= 1;
+    return i;
+    #endif
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+    #define SV_WIDTH (32)
+
+typedef __m256i sv_vec;
+
+static inline sv_vec sv_splat(char c) {
+    return _mm256_set1_epi8(c);
+}
+
+static inline sv_vec sv_load(const char *p) {
+    return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline unsigned sv_eq_mask(sv_vec a, sv_vec b) {
+    return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+}
+
+#elif defined(__SSE2__)
+
+    #define SV_WIDTH (16)
+
+typedef __m128i sv_vec;
+
+static inline sv_vec sv_splat(char c) {
+    return _mm_set1_epi8(c);
+}
+
+static inline sv_vec sv_load(const char *p) {
+    return _mm_loadu_si128((const __m128i *)p);
+}
+
+static inline unsigned sv_eq_mask(sv_vec a, sv_vec b) {
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+}
+
+#endif
+
+static inline bool sv_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v'
+        || c == '\f';
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+size_t strview_find_char(StrView v, char c) {
+    size_t i;
+
+    i = 0;
+
+#ifdef SV_WIDTH
+    {
+        sv_vec needle = sv_splat(c);
+
+        for (; i + SV_WIDTH <= v.len; i += SV_WIDTH) {
+            unsigned mask = sv_eq_mask(sv_load(v.ptr + i), needle);
+
+            if (mask)
+                return i + sv_ctz(mask);
+        }
+    }
+#endif
+
+    for (; i < v.len; i++) {
+        if (v.ptr[i] == c)
+            return i;
+    }
+
+    return STRVIEW_NPOS;
+}
+
+size_t strview_find(StrView v, StrView needle) {
+    size_t i, last;
+
+    if (!needle.len)
+        return 0;
+    if (needle.len > v.len)
+        return STRVIEW_NPOS;
+    if (needle.len == 1)
+        return strview_find_char(v, needle.ptr[0]);
+
+    last = needle.len - 1;
+    i = 0;
+
+#ifdef SV_WIDTH
+    {
+        sv_vec first_c = sv_splat(needle.ptr[0]);
+        sv_vec last_c = sv_splat(needle.ptr[last]);
+
+        for (; i + last + SV_WIDTH <= v.len; i += SV_WIDTH) {
+            unsigned mask = sv_eq_mask(sv_load(v.ptr + i), first_c)
+                & sv_eq_mask(sv_load(v.ptr + i + last), last_c);
+
+            while (mask) {
+                unsigned bit = sv_ctz(mask);
+
+                if (memcmp(v.ptr + i + bit + 1, needle.ptr + 1, last - 1) == 0)
+                    return i + bit;
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    for (; i + last < v.len; i++) {
+        const char *first;
+
+        first = memchr(v.ptr + i, needle.ptr[0], v.len - last - i);
+        if (!first)
+            break;
+        i = first - v.ptr;
+        if (v.ptr[i + last] == needle.ptr[last]
+            && memcmp(v.ptr + i + 1, needle.ptr + 1, last - 1) == 0)
+            return i;
+    }
+
+    return STRVIEW_NPOS;
+}
+
+bool strview_split_next(StrView *rest, char sep, StrView *token) {
+    size_t pos;
+
+    if (!rest->ptr)
+        return false;
+
+    pos = strview_find_char(*rest, sep);
+    if (pos == STRVIEW_NPOS) {
+        *token = *rest;
+        rest->ptr = NULL;
+        rest->len = 0;
+    } else {
+        *token = strview_from(rest->ptr, pos);
+        rest->ptr += pos + 1;
+        rest->len -= pos + 1;
+    }
+
+    return true;
+}
+
+int strview_cmp(StrView a, StrView b) {
+    int cmp;
+
+    cmp = memcmp(a.ptr, b.ptr, a.len < b.len ? a.len : b.len);
+    if (cmp)
+        return cmp;
+    return (a.len > b.len) - (a.len < b.len);
+}
+
+StrView strview_trim_left(StrView v) {
+    while (v.len && sv_is_space(*v.ptr)) {
+        v.ptr++;
+        v.len--;
+    }
+    return v;
+}
+
+StrView strview_trim_right(StrView v) {
+    while (v.len && sv_is_space(v.ptr[v.len - 1]))
+        v.len--;
+    return v;
+}
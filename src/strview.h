@@ -0,0 +1,195 @@
+/**
+ * @file strview.h
+ */
+
+#ifndef __STRVIEW_H__
+#define __STRVIEW_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sstr.h"
+
+/**
+ * @brief returned by the searches when nothing is found
+ */
+#define STRVIEW_NPOS ((size_t)-1)
+
+/**
+ * @brief non-owning view of a range of characters
+ *
+ * not necessarily null-terminated. it's valid as long as the memory it points to is,
+ * for a view of a SStr, until the SStr is modified
+ */
+typedef struct StrView {
+    const char *ptr; /**< first character */
+    size_t len;      /**< number of characters */
+} StrView;
+
+/**
+ * @brief view of @p len characters starting at @p ptr
+ *
+ * @param ptr first character
+ * @param len number of characters
+ * @return StrView
+ */
+inline StrView strview_from(const char *ptr, size_t len) {
+    StrView v;
+
+    v.ptr = ptr;
+    v.len = len;
+    return v;
+}
+
+/**
+ * @brief view of a c-style string
+ *
+ * @param str c-style string
+ * @return StrView
+ */
+inline StrView strview_from_cstr(const char *str) {
+    return strview_from(str, strlen(str));
+}
+
+/**
+ * @brief view of the SStr's characters in [@p pos, @p pos + @p len)
+ *
+ * the range is clamped to the length of @p s
+ *
+ * @param s SStr
+ * @param pos start position
+ * @param len number of characters, STRVIEW_NPOS for all the remaining ones
+ * @return StrView
+ */
+inline StrView strview_from_sstr(SStr *s, size_t pos, size_t len) {
+    if (pos > s->len)
+        pos = s->len;
+    if (len > s->len - pos)
+        len = s->len - pos;
+    return strview_from(sstr_data(s) + pos, len);
+}
+
+/**
+ * @brief sub-view of [@p pos, @p pos + @p len), clamped to the view
+ *
+ * @param v StrView
+ * @param pos start position
+ * @param len number of characters, STRVIEW_NPOS for all the remaining ones
+ * @return StrView
+ */
+inline StrView strview_sub(StrView v, size_t pos, size_t len) {
+    if (pos > v.len)
+        pos = v.len;
+    if (len > v.len - pos)
+        len = v.len - pos;
+    return strview_from(v.ptr + pos, len);
+}
+
+/**
+ * @brief position of the first occurrence of @p c
+ *
+ * vectorized with SSE2/AVX2 when compiled for them
+ *
+ * @param v StrView
+ * @param c character to find
+ * @return position, or STRVIEW_NPOS
+ */
+size_t strview_find_char(StrView v, char c);
+
+/**
+ * @brief position of the first occurrence of @p needle
+ *
+ * with SSE2/AVX2, candidates are filtered comparing the first and last characters of @p needle
+ * on a whole vector of positions at once, and only those matching both are compared fully
+ *
+ * @param v StrView
+ * @param needle StrView to find
+ * @return position, or STRVIEW_NPOS. an empty @p needle is found at 0
+ */
+size_t strview_find(StrView v, StrView needle);
+
+/**
+ * @brief take the next token separated by @p sep, without allocating
+ *
+ * @p rest is the part still to be split, and is advanced past the token.
+ * a view of n separators yields n + 1 tokens, possibly empty.
+ * when there are no more tokens, @p rest gets a NULL pointer
+ *
+ * @param rest StrView to split
+ * @param sep separator
+ * @param token next token
+ * @return false if there are no more tokens
+ */
+bool strview_split_next(StrView *rest, char sep, StrView *token);
+
+/**
+ * @brief if @p v starts with @p prefix
+ *
+ * @param v StrView
+ * @param prefix StrView
+ * @return boolean
+ */
+inline bool strview_starts_with(StrView v, StrView prefix) {
+    return v.len >= prefix.len && memcmp(v.ptr, prefix.ptr, prefix.len) == 0;
+}
+
+/**
+ * @brief if @p v ends with @p suffix
+ *
+ * @param v StrView
+ * @param suffix StrView
+ * @return boolean
+ */
+inline bool strview_ends_with(StrView v, StrView suffix) {
+    return v.len >= suffix.len
+        && memcmp(v.ptr + v.len - suffix.len, suffix.ptr, suffix.len) == 0;
+}
+
+/**
+ * @brief if the two views have the same characters
+ *
+ * @param a StrView
+ * @param b StrView
+ * @return boolean
+ */
+inline bool strview_eq(StrView a, StrView b) {
+    return a.len == b.len && memcmp(a.ptr, b.ptr, a.len) == 0;
+}
+
+/**
+ * @brief lexicographical comparison, like strcmp
+ *
+ * @param a StrView
+ * @param b StrView
+ * @return <0, 0, >0 if @p a is less, equal, greater than @p b
+ */
+int strview_cmp(StrView a, StrView b);
+
+/**
+ * @brief view without the leading whitespace
+ *
+ * @param v StrView
+ * @return StrView
+ */
+StrView strview_trim_left(StrView v);
+
+/**
+ * @brief view without the trailing whitespace
+ *
+ * @param v StrView
+ * @return StrView
+ */
+StrView strview_trim_right(StrView v);
+
+/**
+ * @brief view without the leading and trailing whitespace
+ *
+ * @param v StrView
+ * @return StrView
+ */
+inline StrView strview_trim(StrView v) {
+    return strview_trim_right(strview_trim_left(v));
+}
+
+#endif /* __STRVIEW_H__ */
@@ -0,0 +1,127 @@
+#include "threadpool.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+/**
+ * @brief take and run tasks of the current batch until there are none left
+ *
+ * must be called with the lock held, returns with the lock held
+ *
+ * @param pool ThreadPool
+ */
+static void threadpool_drain(ThreadPool *pool) {
+    while (pool->next < pool->ntasks) {
+        size_t idx = pool->next++;
+
+        pthread_mutex_unlock(&pool->lock);
+        pool->task(idx, pool->ctx);
+        pthread_mutex_lock(&pool->lock);
+
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+    }
+}
+
+static void *threadpool_worker(void *arg) {
+    ThreadPool *pool = arg;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->next >= pool->ntasks)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->quit)
+            break;
+        threadpool_drain(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+int threadpool_init(ThreadPool *pool, size_t nthreads) {
+    size_t i;
+    int err;
+
+    if (!nthreads) {
+        long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        nthreads = ncpus > 1 ? (size_t)ncpus - 1 : 0;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->task = NULL;
+    pool->ctx = NULL;
+    pool->ntasks = 0;
+    pool->next = 0;
+    pool->pending = 0;
+    pool->quit = false;
+    pool->nthreads = 0;
+    pool->threads = nthreads ? malloc(nthreads * sizeof(pthread_t)) : NULL;
+
+    for (i = 0; i < nthreads; i++) {
+        err = pthread_create(&pool->threads[i], NULL, threadpool_worker, pool);
+        if (err) {
+            threadpool_free(pool);
+            return err;
+        }
+        pool->nthreads++;
+    }
+
+    return 0;
+}
+
+void threadpool_free(ThreadPool *pool) {
+    size_t i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->nthreads; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    free(pool->threads);
+    pool->threads = NULL;
+    pool->nthreads = 0;
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+void threadpool_run(ThreadPool *pool, size_t ntasks, Func_Task task, void *ctx) {
+    if (!ntasks)
+        return;
+
+    pthread_mutex_lock(&pool->lock);
+
+    pool->task = task;
+    pool->ctx = ctx;
+    pool->ntasks = ntasks;
+    pool->next = 0;
+    pool->pending = ntasks;
+    if (ntasks > 1)
+        pthread_cond_broadcast(&pool->wake);
+
+    threadpool_drain(pool);
+    while (pool->pending)
+        pthread_cond_wait(&pool->done, &pool->lock);
+
+    pool->ntasks = 0;
+    pool->next = 0;
+
+    pthread_mutex_unlock(&pool->lock);
+}
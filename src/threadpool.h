@@ -0,0 +1,75 @@
+/**
+ * @file threadpool.h
+ */
+
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @brief callback running the task number @p idx
+ */
+typedef void (*Func_Task)(size_t idx, void *ctx);
+
+/**
+ * @brief fixed set of worker threads running batches of tasks
+ */
+typedef struct ThreadPool {
+    pthread_t *threads;    /**< the workers */
+    size_t nthreads;       /**< number of workers */
+    pthread_mutex_t lock;  /**< protects everything below */
+    pthread_cond_t wake;   /**< signaled when a batch starts or the pool quits */
+    pthread_cond_t done;   /**< signaled when the last task of a batch ends */
+    Func_Task task;        /**< task of the current batch */
+    void *ctx;             /**< context of the current batch */
+    size_t ntasks;         /**< number of tasks of the current batch */
+    size_t next;           /**< next task to be taken */
+    size_t pending;        /**< tasks not completed yet */
+    bool quit;             /**< workers must exit */
+} ThreadPool;
+
+/**
+ * @brief start the workers
+ *
+ * the thread calling threadpool_run() works too, so a pool of N workers runs N + 1 tasks at a time
+ *
+ * @param pool ThreadPool
+ * @param nthreads number of workers, 0 for one less than the online CPUs
+ * @return 0 on success, or the error of pthread_create()
+ */
+int threadpool_init(ThreadPool *pool, size_t nthreads);
+
+/**
+ * @brief stop the workers and release the pool
+ *
+ * @param pool ThreadPool
+ */
+void threadpool_free(ThreadPool *pool);
+
+/**
+ * @brief run @p task for every index in [0, @p ntasks), waiting for all of them to complete
+ *
+ * tasks are taken in order by whoever is free, the calling thread included.
+ * only one batch at a time can be run on a pool
+ *
+ * @param pool ThreadPool
+ * @param ntasks number of tasks
+ * @param task callback
+ * @param ctx passed to @p task
+ */
+void threadpool_run(ThreadPool *pool, size_t ntasks, Func_Task task, void *ctx);
+
+/**
+ * @brief number of threads running the tasks, the caller of threadpool_run() included
+ *
+ * @param pool ThreadPool
+ * @return number of threads
+ */
+inline size_t threadpool_concurrency(ThreadPool *pool) {
+    return pool->nthreads + 1;
+}
+
+#endif /* __THREADPOOL_H__ */
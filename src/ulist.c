@@ -0,0 +1,273 @@
+#include "ulist.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* target size of a node, header included */
+#define NODE_SIZE (512UL)
+
+#define MIN_NODE_CAP (4UL)
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static inline size_t ul_node_size(UList *list) {
+    return offsetof(UNode, data) + list->node_cap * list->szof;
+}
+
+static inline char *ul_elem(UList *list, UNode *node, size_t i) {
+    return node->data + (node->start + i) * list->szof;
+}
+
+static UNode *ul_node_new(UList *list, size_t start) {
+    UNode *node;
+
+    node = allocator_alloc(list->allocator, ul_node_size(list));
+    node->next = node->prev = NULL;
+    node->start = start;
+    node->count = 0;
+
+    return node;
+}
+
+/* link @p node after @p prev, or as the head if NULL */
+static void ul_link_after(UList *list, UNode *prev, UNode *node) {
+    node->prev = prev;
+    node->next = prev ? prev->next : list->head;
+    if (node->next)
+        node->next->prev = node;
+    else
+        list->tail = node;
+    if (prev)
+        prev->next = node;
+    else
+        list->head = node;
+}
+
+static void ul_node_free(UList *list, UNode *node) {
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+    allocator_free(list->allocator, node, ul_node_size(list));
+}
+
+/* move the elements at the beginning of the node, to make room at the end */
+static inline void ul_compact(UList *list, UNode *node) {
+    if (node->start) {
+        memmove(node->data, ul_elem(list, node, 0), node->count * list->szof);
+        node->start = 0;
+    }
+}
+
+/**
+ * @brief node holding the element at @p pos, walking from the nearest end
+ *
+ * @param list UList
+ * @param pos index of the element, becomes the index inside the node
+ * @return the node
+ */
+static UNode *ul_find(UList *list, size_t *pos) {
+    UNode *node;
+    size_t i = *pos;
+
+    if (i < list->len / 2) {
+        for (node = list->head; i >= node->count; node = node->next)
+            i -= node->count;
+    } else {
+        // counting the elements after pos
+        i = list->len - i;
+        for (node = list->tail; i > node->count; node = node->prev)
+            i -= node->count;
+        i = node->count - i;
+    }
+
+    *pos = i;
+    return node;
+}
+
+/* move the upper half of a full node to a new one after it */
+static UNode *ul_split(UList *list, UNode *node) {
+    UNode *next;
+    size_t half;
+
+    half = node->count / 2;
+    next = ul_node_new(list, 0);
+    memcpy(next->data, ul_elem(list, node, half), (node->count - half) * list->szof);
+    next->count = node->count - half;
+    node->count = half;
+    ul_link_after(list, node, next);
+
+    return next;
+}
+
+/* move all the elements of @p next at the end of @p node, and free it */
+static void ul_merge(UList *list, UNode *node, UNode *next) {
+    if (node->start + node->count + next->count > list->node_cap)
+        ul_compact(list, node);
+    memcpy(ul_elem(list, node, node->count), ul_elem(list, next, 0), next->count * list->szof);
+    node->count += next->count;
+    ul_node_free(list, next);
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void ulist_new(UList *list, size_t szof) {
+    ulist_new_in(list, szof, NULL);
+}
+
+void ulist_new_in(UList *list, size_t szof, const Allocator *allocator) {
+    list->head = list->tail = NULL;
+    list->len = 0;
+    list->szof = szof;
+    list->node_cap = (NODE_SIZE - offsetof(UNode, data)) / szof;
+    if (list->node_cap < MIN_NODE_CAP)
+        list->node_cap = MIN_NODE_CAP;
+    list->allocator = allocator;
+}
+
+void ulist_free(UList *list) {
+    while (list->head)
+        ul_node_free(list, list->head);
+    list->len = 0;
+}
+
+void *ulist_elem_at(UList *list, size_t pos) {
+    UNode *node;
+
+    if (pos >= list->len)
+        return NULL;
+    node = ul_find(list, &pos);
+    return ul_elem(list, node, pos);
+}
+
+void ulist_push_back(UList *list, void *elem) {
+    UNode *node = list->tail;
+
+    if (!node || node->start + node->count == list->node_cap) {
+        node = ul_node_new(list, 0);
+        ul_link_after(list, list->tail, node);
+    }
+    memcpy(ul_elem(list, node, node->count), elem, list->szof);
+    node->count++;
+    list->len++;
+}
+
+void ulist_push_front(UList *list, void *elem) {
+    UNode *node = list->head;
+
+    if (!node || !node->start) {
+        // filled from the end, so the next pushes at the front are free too
+        node = ul_node_new(list, list->node_cap);
+        ul_link_after(list, NULL, node);
+    }
+    node->start--;
+    node->count++;
+    memcpy(ul_elem(list, node, 0), elem, list->szof);
+    list->len++;
+}
+
+bool ulist_pop_back(UList *list, void *elem) {
+    UNode *node = list->tail;
+
+    if (!node)
+        return false;
+    node->count--;
+    if (elem)
+        memcpy(elem, ul_elem(list, node, node->count), list->szof);
+    if (!node->count)
+        ul_node_free(list, node);
+    list->len--;
+
+    return true;
+}
+
+bool ulist_pop_front(UList *list, void *elem) {
+    UNode *node = list->head;
+
+    if (!node)
+        return false;
+    if (elem)
+        memcpy(elem, ul_elem(list, node, 0), list->szof);
+    node->start++;
+    node->count--;
+    if (!node->count)
+        ul_node_free(list, node);
+    list->len--;
+
+    return true;
+}
+
+void ulist_insert(UList *list, void *elem, size_t pos) {
+    UNode *node;
+    char *at;
+
+    if (pos >= list->len) {
+        ulist_push_back(list, elem);
+        return;
+    }
+    if (pos == 0) {
+        ulist_push_front(list, elem);
+        return;
+    }
+
+    node = ul_find(list, &pos);
+    if (node->count == list->node_cap) {
+        UNode *next = ul_split(list, node);
+
+        if (pos > node->count) {
+            pos -= node->count;
+            node = next;
+        }
+    }
+
+    if (pos == 0 && node->start) {
+        node->start--;
+    } else {
+        if (node->start + node->count == list->node_cap)
+            ul_compact(list, node);
+        at = ul_elem(list, node, pos);
+        memmove(at + list->szof, at, (node->count - pos) * list->szof);
+    }
+    memcpy(ul_elem(list, node, pos), elem, list->szof);
+    node->count++;
+    list->len++;
+}
+
+bool ulist_remove(UList *list, size_t pos, void *elem) {
+    UNode *node;
+    char *at;
+
+    if (pos >= list->len)
+        return false;
+
+    node = ul_find(list, &pos);
+    at = ul_elem(list, node, pos);
+    if (elem)
+        memcpy(elem, at, list->szof);
+    if (pos == 0)
+        node->start++;
+    else
+        memmove(at, at + list->szof, (node->count - pos - 1) * list->szof);
+    node->count--;
+    list->len--;
+
+    if (!node->count)
+        ul_node_free(list, node);
+    else if (node->count < list->node_cap / 2) {
+        if (node->next && node->count + node->next->count <= list->node_cap)
+            ul_merge(list, node, node->next);
+        else if (node->prev && node->prev->count + node->count <= list->node_cap)
+            ul_merge(list, node->prev, node);
+    }
+
+    return true;
+}
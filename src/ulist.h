@@ -0,0 +1,216 @@
+/**
+ * @file ulist.h
+ */
+
+#ifndef __ULIST_H__
+#define __ULIST_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+
+/**
+ * @brief node of an unrolled list, holding up to node_cap elements
+ */
+typedef struct UNode {
+    struct UNode *next; /**< the next node */
+    struct UNode *prev; /**< the previous node */
+    size_t start;       /**< index in @p data of the first element */
+    size_t count;       /**< number of elements, never 0 */
+    char data[];        /**< the elements */
+} UNode;
+
+/**
+ * @brief unrolled linked list
+ *
+ * a linked list of small arrays: elements are stored by value inside the nodes, so scanning is
+ * mostly sequential memory, while inserting and removing only shift the elements of one node.
+ * full nodes are split in two, nodes less than half full are merged with a neighbour when they fit.
+ * elements move when their node changes, so pointers to them are valid until the next change
+ */
+typedef struct UList {
+    UNode *head;     /**< first node */
+    UNode *tail;     /**< last node */
+    size_t len;      /**< number of elements */
+    size_t szof;     /**< sizeof() of the data type to be held */
+    size_t node_cap; /**< elements per node */
+    const Allocator *allocator; /**< where the nodes come from, NULL for malloc */
+} UList;
+
+/**
+ * @brief iterator over a UList
+ */
+typedef struct UListIter {
+    UNode *node; /**< next node to visit */
+    char *cur;   /**< next element of the current node */
+    char *end;   /**< end of the elements of the current node */
+    size_t szof; /**< sizeof() of the elements */
+} UListIter;
+
+/**
+ * @brief new UList
+ *
+ * nodes are sized to about 512 bytes, and hold at least 4 elements
+ *
+ * @param list UList
+ * @param szof size of the single elements it's going to contain
+ */
+void ulist_new(UList *list, size_t szof);
+
+/**
+ * @brief new UList using @p allocator for the nodes
+ *
+ * @param list UList
+ * @param szof size of the single elements it's going to contain
+ * @param allocator Allocator, must outlive the UList. NULL for malloc
+ */
+void ulist_new_in(UList *list, size_t szof, const Allocator *allocator);
+
+/**
+ * @brief release all the nodes
+ *
+ * if the single elements own memory, that needs to be release before by the caller
+ *
+ * @param list UList
+ */
+void ulist_free(UList *list);
+
+/**
+ * @brief return pointer to element at @p pos
+ *
+ * walks the nodes from the nearest end.
+ * if changes to the UList are made, this pointer can become invalid
+ *
+ * @param list UList
+ * @param pos index of the element
+ * @return pointer to element, or NULL
+ */
+void *ulist_elem_at(UList *list, size_t pos);
+
+/**
+ * @brief insert element at the end through shallow-copy
+ *
+ * @param list UList
+ * @param elem element to insert
+ */
+void ulist_push_back(UList *list, void *elem);
+
+/**
+ * @brief insert element at the beginning through shallow-copy
+ *
+ * @param list UList
+ * @param elem element to insert
+ */
+void ulist_push_front(UList *list, void *elem);
+
+/**
+ * @brief remove element from the end
+ *
+ * @param list UList
+ * @param elem element removed, can be NULL
+ * @return false if the UList was empty
+ */
+bool ulist_pop_back(UList *list, void *elem);
+
+/**
+ * @brief remove element from the beginning
+ *
+ * @param list UList
+ * @param elem element removed, can be NULL
+ * @return false if the UList was empty
+ */
+bool ulist_pop_front(UList *list, void *elem);
+
+/**
+ * @brief insert element at @p pos through shallow-copy
+ *
+ * @param list UList
+ * @param elem element to insert
+ * @param pos index, up to the length
+ */
+void ulist_insert(UList *list, void *elem, size_t pos);
+
+/**
+ * @brief remove element at @p pos
+ *
+ * @param list UList
+ * @param pos index of the element
+ * @param elem element removed, can be NULL
+ * @return false if @p pos is out of bounds
+ */
+bool ulist_remove(UList *list, size_t pos, void *elem);
+
+/**
+ * @brief start iterating from the first element
+ *
+ * @param list UList
+ * @param it iterator
+ */
+inline void ulist_iter(UList *list, UListIter *it) {
+    it->node = list->head;
+    it->cur = it->end = NULL;
+    it->szof = list->szof;
+}
+
+/**
+ * @brief next element
+ *
+ * @param it iterator
+ * @return pointer to the element, NULL at the end
+ */
+inline void *ulist_iter_next(UListIter *it) {
+    void *elem;
+
+    if (it->cur == it->end) {
+        if (!it->node)
+            return NULL;
+        it->cur = it->node->data + it->node->start * it->szof;
+        it->end = it->cur + it->node->count * it->szof;
+        it->node = it->node->next;
+    }
+    elem = it->cur;
+    it->cur += it->szof;
+
+    return elem;
+}
+
+/**
+ * @brief next run of contiguous elements, up to the end of the current node
+ *
+ * to scan whole arrays at a time. can be mixed with ulist_iter_next()
+ *
+ * @param it iterator
+ * @param nelem number of elements of the run
+ * @return pointer to the first element of the run, NULL at the end
+ */
+inline void *ulist_iter_next_chunk(UListIter *it, size_t *nelem) {
+    void *elems;
+
+    if (it->cur == it->end) {
+        if (!it->node) {
+            *nelem = 0;
+            return NULL;
+        }
+        it->cur = it->node->data + it->node->start * it->szof;
+        it->end = it->cur + it->node->count * it->szof;
+        it->node = it->node->next;
+    }
+    elems = it->cur;
+    *nelem = (size_t)(it->end - it->cur) / it->szof;
+    it->cur = it->end;
+
+    return elems;
+}
+
+/**
+ * @brief if UList is empty
+ *
+ * @param list UList
+ * @return boolean
+ */
+inline bool ulist_is_empty(UList *list) {
+    return list->len == 0;
+}
+
+#endif /* __ULIST_H__ */
@@ -9,19 +9,43 @@ static inline char *vec_ptr(Vec *v, size_t pos) {
     return ((char *)v->ptr) + (pos * v->szof);
 }
 
-static inline void vec_alloc(Vec *v, size_t nelem) {
-    v->ptr = malloc(nelem * v->szof);
+/*
+ * when the allocator fails, the Vec keeps its previous memory and capacity,
+ * callers find out by the capacity not having grown
+ */
+static inline bool vec_alloc(Vec *v, size_t nelem) {
+    void *ptr;
+
+    if ((ptr = allocator_alloc(v->allocator, nelem * v->szof)) == NULL)
+        return false;
+    v->ptr = ptr;
     v->cap = nelem;
+    return true;
 }
 
 static inline void vec_realloc(Vec *v, size_t nelem) {
-    v->ptr = realloc(v->ptr, nelem * v->szof);
+    void *ptr;
+
+    ptr = allocator_realloc(
+        v->allocator,
+        v->ptr,
+        v->cap * v->szof,
+        nelem * v->szof
+    );
+    if (ptr == NULL)
+        return;
+    v->ptr = ptr;
     v->cap = nelem;
 }
 
+static inline bool vec_on_heap(Vec *v) {
+    return v->cap && v->ptr != v->inl;
+}
+
 /**
  * @brief resize Vec.
  * 
+ * if fits inline, move back to the inline storage
  * if shrink, realloc by exact number
  * if grow  , realloc by GROWTH_FACTOR when possible, otherwise exact number
  * 
@@ -29,13 +53,30 @@ static inline void vec_realloc(Vec *v, size_t nelem) {
  * @param nelem number of elements requested
  */
 static void vec_resize(Vec *v, size_t nelem) {
-    if (v->cap) {
+    if (v->inl && nelem <= v->inl_cap) {
+        if (v->ptr != v->inl) {
+            vec_memcpy(v, v->inl, v->ptr, v->len);
+            allocator_free(v->allocator, v->ptr, v->cap * v->szof);
+            v->ptr = v->inl;
+            v->cap = v->inl_cap;
+        }
+    } else if (vec_on_heap(v)) {
         if (nelem < v->cap || nelem > v->cap * GROWTH_FACTOR)
             vec_realloc(v, nelem);
         else if (nelem > v->cap)
             vec_realloc(v, v->cap * GROWTH_FACTOR);
     } else {
-        vec_alloc(v, nelem > GROWTH_FACTOR ? nelem : GROWTH_FACTOR);
+        // either not allocated (cap == 0) or spilling out of the inline storage
+        size_t grown;
+        void *prev;
+
+        grown = v->cap * GROWTH_FACTOR;
+        if (grown < GROWTH_FACTOR)
+            grown = GROWTH_FACTOR;
+
+        prev = v->ptr;
+        if (vec_alloc(v, nelem > grown ? nelem : grown) && v->len)
+            vec_memcpy(v, v->ptr, prev, v->len);
     }
 }
 
@@ -43,6 +84,40 @@ void vec_new(Vec *v, size_t szof) {
     v->cap = 0;
     v->len = 0;
     v->szof = szof;
+    v->allocator = NULL;
+    v->inl = NULL;
+    v->inl_cap = 0;
+}
+
+bool vec_new_aligned(Vec *v, size_t szof, size_t align) {
+    const Allocator *allocator;
+
+    if ((allocator = allocator_aligned(align, false)) == NULL)
+        return false;
+    vec_new_in(v, szof, allocator);
+    return true;
+}
+
+bool vec_new_huge(Vec *v, size_t szof, size_t align) {
+    const Allocator *allocator;
+
+    if ((allocator = allocator_aligned(align, true)) == NULL)
+        return false;
+    vec_new_in(v, szof, allocator);
+    return true;
+}
+
+void vec_new_inline(Vec *v, size_t szof, void *buf, size_t nelem) {
+    vec_new(v, szof);
+    v->inl = buf;
+    v->inl_cap = nelem;
+    v->ptr = buf;
+    v->cap = nelem;
+}
+
+void vec_new_in(Vec *v, size_t szof, const Allocator *allocator) {
+    vec_new(v, szof);
+    v->allocator = allocator;
 }
 
 void vec_new_with(Vec *v, size_t szof, size_t nelem) {
@@ -51,20 +126,23 @@ void vec_new_with(Vec *v, size_t szof, size_t nelem) {
 }
 
 void vec_new_with_zeroed(Vec *v, size_t szof, size_t nelem) {
-    vec_new_with(v, nelem, szof);
+    vec_new_with(v, szof, nelem);
+    if (v->cap < nelem)
+        return;
     vec_memset(v, v->ptr, 0, nelem);
     v->len = nelem;
 }
 
 void vec_from(Vec *v, size_t szof, void *arr, size_t nelem) {
     vec_new(v, szof);
-    vec_insert_n(v, arr, 0, nelem);
+    vec_insert_n(v, arr, nelem, 0);
 }
 
 void vec_free(Vec *v) {
-    if (v->cap)
-        free(v->ptr);
-    v->cap = 0;
+    if (vec_on_heap(v))
+        allocator_free(v->allocator, v->ptr, v->cap * v->szof);
+    v->ptr = v->inl;
+    v->cap = v->inl_cap;
     v->len = 0;
 }
 
@@ -95,12 +173,36 @@ void vec_set(Vec *v, void *elem, size_t pos) {
 void vec_insert_n(Vec *v, void *elems, size_t nelem, size_t pos) {
     if (pos <= v->len) {
         vec_reserve(v, v->len + nelem);
+        if (v->cap < v->len + nelem)
+            return;
         vec_memmove(v, vec_ptr(v, pos + nelem), vec_ptr(v, pos), v->len - pos);
         vec_memcpy(v, vec_ptr(v, pos), elems, nelem);
         v->len += nelem;
     }
 }
 
+void *vec_push_uninit_n(Vec *v, size_t nelem) {
+    char *elems;
+
+    vec_reserve(v, v->len + nelem);
+    if (v->cap < v->len + nelem)
+        return NULL;
+    elems = vec_ptr(v, v->len);
+    v->len += nelem;
+
+    return elems;
+}
+
+void vec_extend(Vec *dest, Vec *source) {
+    if (source->len && dest->szof == source->szof) {
+        vec_reserve(dest, dest->len + source->len);
+        if (dest->cap < dest->len + source->len)
+            return;
+        vec_memcpy(dest, vec_ptr(dest, dest->len), source->ptr, source->len);
+        dest->len += source->len;
+    }
+}
+
 void vec_remove_n(Vec *v, size_t pos, void *elems, size_t nelem) {
     if (pos + nelem - 1 < v->len) {
         if (elems)
@@ -116,6 +218,57 @@ void vec_remove_n(Vec *v, size_t pos, void *elems, size_t nelem) {
     }
 }
 
+void vec_swap_remove(Vec *v, size_t pos, void *elem) {
+    if (pos < v->len) {
+        if (elem)
+            vec_memcpy(v, elem, vec_ptr(v, pos), 1);
+        v->len--;
+        if (pos < v->len)
+            vec_memcpy(v, vec_ptr(v, pos), vec_ptr(v, v->len), 1);
+    }
+}
+
+/**
+ * @brief compact the Vec, removing the elements for which @p pred returns @p remove_if
+ *
+ * @param v Vec
+ * @param pred predicate
+ * @param remove_if result of @p pred for the elements to remove
+ * @param drain receives the removed elements, can be NULL
+ * @param ctx passed to @p pred and @p drain
+ */
+static void vec_compact(
+    Vec *v,
+    Func_Pred pred,
+    bool remove_if,
+    Func_Elem drain,
+    void *ctx
+) {
+    size_t i, kept;
+
+    for (i = 0, kept = 0; i < v->len; i++) {
+        char *elem = vec_ptr(v, i);
+
+        if (pred(elem, ctx) == remove_if) {
+            if (drain)
+                drain(elem, ctx);
+        } else {
+            if (kept != i)
+                vec_memcpy(v, vec_ptr(v, kept), elem, 1);
+            kept++;
+        }
+    }
+    v->len = kept;
+}
+
+void vec_retain(Vec *v, Func_Pred pred, void *ctx) {
+    vec_compact(v, pred, false, NULL, ctx);
+}
+
+void vec_drain_filter(Vec *v, Func_Pred pred, Func_Elem drain, void *ctx) {
+    vec_compact(v, pred, true, drain, ctx);
+}
+
 void vec_swap(Vec *v, size_t pos1, size_t pos2, void *tmp) {
     if (pos1 < v->len && pos2 < v->len) {
         vec_memcpy(v, tmp, vec_ptr(v, pos1), 1);
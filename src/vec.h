@@ -9,6 +9,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "allocator.h"
+
+/**
+ * @brief callback to test an element
+ */
+typedef bool (*Func_Pred)(void *elem, void *ctx);
+
+/**
+ * @brief callback receiving an element
+ */
+typedef void (*Func_Elem)(void *elem, void *ctx);
+
 /**
  * @brief dynamic array
  */
@@ -17,6 +29,9 @@ typedef struct Vec {
     size_t cap; /**< number of elements for which there is space allocated */
     size_t len; /**< number of usable elements */
     size_t szof; /**< sizeof() of the data type to be held */
+    const Allocator *allocator; /**< where the memory comes from, NULL for malloc */
+    void *inl; /**< caller-provided inline storage, or NULL */
+    size_t inl_cap; /**< number of elements that fit in the inline storage */
 } Vec;
 
 /**
@@ -29,6 +44,57 @@ typedef struct Vec {
  */
 void vec_new(Vec *v, size_t szof);
 
+/**
+ * @brief new Vec using @p allocator for its memory
+ *
+ * the Vec is not allocated, therefore vec_data() returns NULL
+ *
+ * @param v Vec
+ * @param szof size of the single elements it's going to contain
+ * @param allocator Allocator, must outlive the Vec. NULL for malloc
+ */
+void vec_new_in(Vec *v, size_t szof, const Allocator *allocator);
+
+/**
+ * @brief new Vec whose memory is aligned to @p align
+ *
+ * the alignment is kept when the Vec grows or shrinks, so vec_data() can be used with aligned SIMD loads
+ *
+ * @param v Vec
+ * @param szof size of the single elements it's going to contain
+ * @param align power of two, up to 4096
+ * @return false if @p align isn't supported, @p v is left untouched
+ */
+bool vec_new_aligned(Vec *v, size_t szof, size_t align);
+
+/**
+ * @brief new Vec whose memory is aligned to @p align, using huge pages when it's big
+ *
+ * like vec_new_aligned(), but once the Vec reaches 2 MiB it's backed by transparent huge pages,
+ * reducing TLB misses on big Vecs
+ *
+ * @param v Vec
+ * @param szof size of the single elements it's going to contain
+ * @param align power of two, up to 4096
+ * @return false if @p align isn't supported, @p v is left untouched
+ */
+bool vec_new_huge(Vec *v, size_t szof, size_t align);
+
+/**
+ * @brief new Vec with caller-provided inline storage
+ *
+ * elements are kept in @p buf until they outgrow it, only then they are moved to the heap.
+ * vec_shrink_to_fit() and vec_free() move them back in @p buf when they fit.
+ * @p buf is typically on the stack or embedded in the struct containing the Vec,
+ * but since the Vec points to it, if the Vec is moved it must be moved along with it
+ *
+ * @param v Vec
+ * @param szof size of the single elements it's going to contain
+ * @param buf inline storage, must outlive the Vec
+ * @param nelem number of elements that fit in @p buf
+ */
+void vec_new_inline(Vec *v, size_t szof, void *buf, size_t nelem);
+
 /**
  * @brief new Vec with reserved space
  *
@@ -67,6 +133,7 @@ void vec_from(Vec *v, size_t szof, void *arr, size_t nelem);
  * @brief release memory
  *
  * doesn't reset szof.
+ * if the Vec has inline storage, it goes back to using it.
  * if the single elements own memory, that needs to be release before by the caller
  *
  * @param v Vec
@@ -85,6 +152,9 @@ inline void vec_truncate(Vec *v) {
 /**
  * @brief reserve memory ahead of time
  *
+ * if the memory can't be allocated the Vec is left as it was, with the same capacity.
+ * the functions that grow the Vec then leave it unchanged
+ *
  * @param v Vec
  * @param nelem number of elements to reserve memory for
  */
@@ -173,6 +243,40 @@ inline void vec_insert(Vec *v, void *elem, size_t pos) {
     vec_insert_n(v, elem, 1, pos);
 }
 
+/**
+ * @brief grow the length by @p nelem uninitialized elements at the end
+ *
+ * the returned pointer is where the new elements start, to be written directly (e.g. by read()).
+ * if changes to the Vec are made, this pointer can become invalid
+ *
+ * @param v Vec
+ * @param nelem number of elements to add
+ * @return pointer to the first new element, or NULL if the memory couldn't be allocated
+ */
+void *vec_push_uninit_n(Vec *v, size_t nelem);
+
+/**
+ * @brief add one uninitialized element at the end, to be constructed in place
+ *
+ * if changes to the Vec are made, this pointer can become invalid
+ *
+ * @param v Vec
+ * @return pointer to the new element
+ */
+inline void *vec_emplace_back(Vec *v) {
+    return vec_push_uninit_n(v, 1);
+}
+
+/**
+ * @brief append all the elements of @p source at the end of @p dest through shallow-copy
+ *
+ * memory is reserved once. the Vecs must hold elements of the same size
+ *
+ * @param dest Vec
+ * @param source Vec
+ */
+void vec_extend(Vec *dest, Vec *source);
+
 /**
  * @brief bulk remove elements starting at pos, shifting the ones after
  *
@@ -213,6 +317,45 @@ inline void vec_remove(Vec *v, size_t pos, void *elem) {
     vec_remove_n(v, pos, elem, 1);
 }
 
+/**
+ * @brief remove element from pos, replacing it with the last one
+ *
+ * O(1), but doesn't preserve the order of the elements.
+ * doesn't deallocate memory
+ * if the element owns memory, that needs to be freed through @p elem
+ *
+ * @param v Vec
+ * @param pos index of the element
+ * @param elem element removed, can be NULL
+ */
+void vec_swap_remove(Vec *v, size_t pos, void *elem);
+
+/**
+ * @brief keep only the elements for which @p pred returns true
+ *
+ * single pass, preserves the order of the elements kept.
+ * doesn't deallocate memory
+ *
+ * @param v Vec
+ * @param pred predicate
+ * @param ctx passed to @p pred
+ */
+void vec_retain(Vec *v, Func_Pred pred, void *ctx);
+
+/**
+ * @brief remove the elements for which @p pred returns true, handing them to @p drain
+ *
+ * single pass, preserves the order of the elements kept.
+ * doesn't deallocate memory
+ * if the elements own memory, that can be freed by @p drain
+ *
+ * @param v Vec
+ * @param pred predicate
+ * @param drain receives the removed elements before they're overwritten, can be NULL
+ * @param ctx passed to @p pred and @p drain
+ */
+void vec_drain_filter(Vec *v, Func_Pred pred, Func_Elem drain, void *ctx);
+
 /**
  * @brief if Vec is empty
  *
@@ -284,4 +427,116 @@ inline int vec_memcmp(Vec *v, void *ptr1, void *ptr2, size_t nelem) {
     return memcmp(ptr1, ptr2, nelem * v->szof);
 }
 
+/**
+ * @brief generate functions specialized for a Vec holding elements of type @p T
+ *
+ * the generated functions are named Name_xxx and operate on a plain Vec, so they can be mixed with the generic ones,
+ * as long as the Vec holds elements of sizeof(T) (Name_new takes care of that).
+ * the element size being a compile-time constant, accesses compile down to plain loads and stores
+ * and the generic path (vec_insert_n() and a variable-length memcpy) is only taken when the Vec needs to grow.
+ * semantics are the same as the corresponding vec_* function
+ *
+ * @param Name prefix of the generated functions
+ * @param T type of the elements
+ */
+#define VEC_DEFINE(Name, T) \
+    static inline void Name##_new(Vec *v) { \
+        vec_new(v, sizeof(T)); \
+    } \
+\
+    static inline T *Name##_data(Vec *v) { \
+        return (T *)vec_data(v); \
+    } \
+\
+    static inline T *Name##_elem_at(Vec *v, size_t pos) { \
+        if (pos < v->len) \
+            return ((T *)v->ptr) + pos; \
+        return NULL; \
+    } \
+\
+    static inline void Name##_get(Vec *v, size_t pos, T *elem) { \
+        if (pos < v->len) \
+            *elem = ((T *)v->ptr)[pos]; \
+    } \
+\
+    static inline void Name##_set(Vec *v, T elem, size_t pos) { \
+        if (pos < v->len) \
+            ((T *)v->ptr)[pos] = elem; \
+    } \
+\
+    static inline void Name##_push(Vec *v, T elem) { \
+        if (v->len == v->cap) { \
+            vec_reserve(v, v->len + 1); \
+            if (v->len == v->cap) \
+                return; \
+        } \
+        ((T *)v->ptr)[v->len++] = elem; \
+    } \
+\
+    static inline void Name##_pop(Vec *v, T *elem) { \
+        if (v->len) { \
+            v->len--; \
+            if (elem) \
+                *elem = ((T *)v->ptr)[v->len]; \
+        } \
+    } \
+\
+    static inline void Name##_insert_n( \
+        Vec *v, const T *elems, size_t nelem, size_t pos \
+    ) { \
+        if (pos <= v->len) { \
+            T *p; \
+\
+            if (v->len + nelem > v->cap) \
+                vec_reserve(v, v->len + nelem); \
+            p = ((T *)v->ptr) + pos; \
+            if (pos < v->len) \
+                memmove(p + nelem, p, (v->len - pos) * sizeof(T)); \
+            memcpy(p, elems, nelem * sizeof(T)); \
+            v->len += nelem; \
+        } \
+    } \
+\
+    static inline void Name##_insert(Vec *v, T elem, size_t pos) { \
+        if (pos <= v->len) { \
+            T *p; \
+\
+            if (v->len == v->cap) \
+                vec_reserve(v, v->len + 1); \
+            p = ((T *)v->ptr) + pos; \
+            if (pos < v->len) \
+                memmove(p + 1, p, (v->len - pos) * sizeof(T)); \
+            *p = elem; \
+            v->len++; \
+        } \
+    } \
+\
+    static inline void Name##_remove_n( \
+        Vec *v, size_t pos, T *elems, size_t nelem \
+    ) { \
+        if (nelem && pos + nelem - 1 < v->len) { \
+            T *p; \
+\
+            p = ((T *)v->ptr) + pos; \
+            if (elems) \
+                memcpy(elems, p, nelem * sizeof(T)); \
+            if (pos + nelem < v->len) \
+                memmove(p, p + nelem, (v->len - (pos + nelem)) * sizeof(T)); \
+            v->len -= nelem; \
+        } \
+    } \
+\
+    static inline void Name##_remove(Vec *v, size_t pos, T *elem) { \
+        if (pos < v->len) { \
+            T *p; \
+\
+            p = ((T *)v->ptr) + pos; \
+            if (elem) \
+                *elem = *p; \
+            if (pos + 1 < v->len) \
+                memmove(p, p + 1, (v->len - (pos + 1)) * sizeof(T)); \
+            v->len--; \
+        } \
+    }
+
 #endif /* __VEC_H__ */
\ No newline at end of file
@@ -0,0 +1,281 @@
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE /* mremap() */
+#endif
+
+#include "vec_map.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define VECMAP_MAGIC "VECMAP1"
+
+/* the elements start after the header, on a cache line boundary */
+#define VECMAP_HEADER_SIZE (64UL)
+
+/**
+ * @brief beginning of the file
+ */
+typedef struct VecMapHeader {
+    char magic[8];
+    uint64_t szof;
+    uint64_t len;
+} VecMapHeader;
+
+/**
+ * @brief state of a mapped Vec, it's also its Allocator
+ *
+ * the mapping can back a single buffer, the Vec's own. any other allocation made through the
+ * Allocator goes to malloc. the map is only released by vec_close_mapped()
+ */
+typedef struct VecMap {
+    Allocator allocator;
+    int fd;
+    char *base;    /* the mapping, header included */
+    size_t nbytes; /* size of the mapping */
+    bool in_use;   /* if the elements part of the mapping is the Vec's buffer */
+} VecMap;
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static inline VecMapHeader *vecmap_header(VecMap *map) {
+    return (VecMapHeader *)map->base;
+}
+
+/**
+ * @brief resize file and mapping to hold @p nbytes of elements
+ *
+ * when growing the file is extended before the mapping, when shrinking after,
+ * so no page of the mapping is ever past the end of the file
+ *
+ * @param map VecMap
+ * @param nbytes bytes of elements
+ * @return 0 on success, -1 on failure
+ */
+static int vecmap_remap(VecMap *map, size_t nbytes) {
+    size_t total, prev;
+    void *base;
+
+    total = VECMAP_HEADER_SIZE + nbytes;
+    prev = map->nbytes;
+    if (total == prev)
+        return 0;
+
+    if (total > prev && ftruncate(map->fd, (off_t)total) != 0)
+        return -1;
+
+#ifdef MREMAP_MAYMOVE
+    base = mremap(map->base, prev, total, MREMAP_MAYMOVE);
+#else
+    // the mapping is shared with the file, so remapping it doesn't lose anything
+    munmap(map->base, prev);
+    base = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, map->fd, 0);
+#endif
+    if (base == MAP_FAILED)
+        return -1;
+
+    map->base = base;
+    map->nbytes = total;
+
+    // the synced length must stay within the file, or it couldn't be opened again
+    if (vecmap_header(map)->len > nbytes / vecmap_header(map)->szof)
+        vecmap_header(map)->len = nbytes / vecmap_header(map)->szof;
+
+    if (total < prev && ftruncate(map->fd, (off_t)total) != 0)
+        return -1;
+
+    return 0;
+}
+
+static inline void *vecmap_data(VecMap *map) {
+    return map->base + VECMAP_HEADER_SIZE;
+}
+
+static inline bool vecmap_owns(VecMap *map, void *ptr) {
+    return map->in_use && ptr == vecmap_data(map);
+}
+
+/**
+ * @brief unmap and close, the map is released
+ *
+ * @param map VecMap
+ * @return 0 on success, -1 on failure
+ */
+static int vecmap_close(VecMap *map) {
+    int ret = 0;
+
+    if (munmap(map->base, map->nbytes) != 0)
+        ret = -1;
+    if (close(map->fd) != 0)
+        ret = -1;
+    free(map);
+
+    return ret;
+}
+
+static void *vecmap_alloc(void *ctx, size_t nbytes) {
+    VecMap *map = ctx;
+
+    if (map->in_use)
+        return malloc(nbytes);
+
+    if (vecmap_remap(map, nbytes) != 0)
+        return NULL;
+    map->in_use = true;
+    return vecmap_data(map);
+}
+
+static void *vecmap_realloc(void *ctx, void *ptr, size_t old_nbytes, size_t nbytes) {
+    VecMap *map = ctx;
+
+    (void)old_nbytes;
+    if (!ptr)
+        return vecmap_alloc(ctx, nbytes);
+    if (!vecmap_owns(map, ptr))
+        return realloc(ptr, nbytes);
+
+    if (vecmap_remap(map, nbytes) != 0)
+        return NULL;
+    return vecmap_data(map);
+}
+
+/*
+ * freeing the Vec's buffer only shrinks the file to the header, the map stays open
+ * and backs the buffer again at the next allocation
+ */
+static void vecmap_free(void *ctx, void *ptr, size_t nbytes) {
+    VecMap *map = ctx;
+
+    (void)nbytes;
+    if (!vecmap_owns(map, ptr)) {
+        free(ptr);
+        return;
+    }
+
+    vecmap_remap(map, 0);
+    map->in_use = false;
+}
+
+static inline VecMap *vec_map(Vec *v) {
+    return (VecMap *)v->allocator->ctx;
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+int vec_open_mapped(Vec *v, const char *path, size_t szof) {
+    VecMap *map;
+    VecMapHeader *header;
+    struct stat st;
+    int fd;
+
+    if (!szof) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if ((fd = open(path, O_RDWR | O_CREAT, 0644)) < 0)
+        return -1;
+
+    if (fstat(fd, &st) != 0)
+        goto err_close;
+
+    if (st.st_size == 0) {
+        if (ftruncate(fd, (off_t)VECMAP_HEADER_SIZE) != 0)
+            goto err_close;
+        st.st_size = VECMAP_HEADER_SIZE;
+    } else if ((size_t)st.st_size < VECMAP_HEADER_SIZE
+               || ((size_t)st.st_size - VECMAP_HEADER_SIZE) % szof) {
+        errno = EINVAL;
+        goto err_close;
+    }
+
+    if ((map = malloc(sizeof(VecMap))) == NULL)
+        goto err_close;
+    map->fd = fd;
+    map->nbytes = (size_t)st.st_size;
+    map->base = mmap(
+        NULL,
+        map->nbytes,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd,
+        0
+    );
+    if (map->base == MAP_FAILED)
+        goto err_free;
+
+    header = vecmap_header(map);
+    if (header->magic[0] == '\0') {
+        memcpy(header->magic, VECMAP_MAGIC, sizeof(header->magic));
+        header->szof = szof;
+        header->len = 0;
+    } else if (memcmp(header->magic, VECMAP_MAGIC, sizeof(header->magic))
+               || header->szof != szof
+               || header->len > (map->nbytes - VECMAP_HEADER_SIZE) / szof) {
+        munmap(map->base, map->nbytes);
+        errno = EINVAL;
+        goto err_free;
+    }
+
+    map->allocator.alloc = vecmap_alloc;
+    map->allocator.realloc = vecmap_realloc;
+    map->allocator.free = vecmap_free;
+    map->allocator.ctx = map;
+
+    vec_new_in(v, szof, &map->allocator);
+    v->cap = (map->nbytes - VECMAP_HEADER_SIZE) / szof;
+    v->len = header->len;
+    v->ptr = v->cap ? vecmap_data(map) : NULL;
+    map->in_use = v->cap > 0;
+
+    return 0;
+
+err_free:
+    free(map);
+err_close:
+    close(fd);
+    return -1;
+}
+
+bool vec_is_mapped(Vec *v) {
+    return v->allocator && v->allocator->alloc == vecmap_alloc;
+}
+
+int vec_sync_mapped(Vec *v) {
+    VecMap *map;
+
+    if (!vec_is_mapped(v)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    map = vec_map(v);
+    vecmap_header(map)->len = v->len;
+    return msync(map->base, map->nbytes, MS_SYNC);
+}
+
+int vec_close_mapped(Vec *v) {
+    int ret;
+
+    if (!vec_is_mapped(v)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ret = vec_sync_mapped(v);
+    if (vecmap_close(vec_map(v)) != 0)
+        ret = -1;
+
+    vec_new(v, v->szof);
+
+    return ret;
+}
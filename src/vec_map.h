@@ -0,0 +1,58 @@
+/**
+ * @file vec_map.h
+ */
+
+#ifndef __VEC_MAP_H__
+#define __VEC_MAP_H__
+
+#include <stdlib.h>
+
+#include "vec.h"
+
+/**
+ * @brief open a Vec backed by a memory-mapped file
+ *
+ * if @p path doesn't exist or is empty, it's created with an empty Vec.
+ * otherwise the Vec is mapped as it was last synced, without reading or parsing anything.
+ * the file grows with ftruncate() and mremap(), so the elements are never copied around,
+ * and can be bigger than the available RAM.
+ * the elements must not contain pointers, since they're persisted as they are.
+ * the Vec must not be moved in memory while it's mapped.
+ * vec_free() and vec_shrink_to_fit() shrink the file along with the Vec, but it stays mapped
+ * until vec_close_mapped()
+ *
+ * @param v Vec
+ * @param path path of the file
+ * @param szof size of the single elements it's going to contain
+ * @return 0 on success, -1 on failure (errno is set, or EINVAL if @p szof is 0 or the file isn't a Vec of @p szof elements)
+ */
+int vec_open_mapped(Vec *v, const char *path, size_t szof);
+
+/**
+ * @brief if the Vec was opened by vec_open_mapped()
+ *
+ * @param v Vec
+ * @return boolean
+ */
+bool vec_is_mapped(Vec *v);
+
+/**
+ * @brief persist the length and the elements to the file
+ *
+ * @param v Vec opened by vec_open_mapped()
+ * @return 0 on success, -1 on failure (errno is set, EINVAL if @p v isn't mapped)
+ */
+int vec_sync_mapped(Vec *v);
+
+/**
+ * @brief sync and close the Vec
+ *
+ * the file keeps the capacity reserved, vec_shrink_to_fit() before closing to trim it.
+ * after the call the Vec is empty and unallocated
+ *
+ * @param v Vec opened by vec_open_mapped()
+ * @return 0 on success, -1 on failure (errno is set, EINVAL if @p v isn't mapped)
+ */
+int vec_close_mapped(Vec *v);
+
+#endif /* __VEC_MAP_H__ */
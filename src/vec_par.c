@@ -0,0 +1,303 @@
+#include "vec_par.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* roughly what fits in a core's L2 */
+#define CHUNK_BYTES (256UL * 1024UL)
+
+typedef struct ParCtx {
+    Vec *v;
+    Vec *dest;
+    size_t chunk;  /* elements per chunk */
+    union {
+        Func_Elem elem;
+        Func_Map map;
+        Func_Fold fold;
+    } func;
+    void *ctx;
+    char *accs;    /* vec_par_reduce(): one accumulator per chunk */
+    size_t acc_szof;
+} ParCtx;
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static inline char *par_ptr(Vec *v, size_t pos) {
+    return ((char *)v->ptr) + (pos * v->szof);
+}
+
+/**
+ * @brief split the Vec in chunks of at least one element and about CHUNK_BYTES
+ *
+ * @param c ParCtx
+ * @return number of chunks
+ */
+static size_t par_chunks(ParCtx *c) {
+    c->chunk = CHUNK_BYTES / c->v->szof;
+    if (!c->chunk)
+        c->chunk = 1;
+    return (c->v->len + c->chunk - 1) / c->chunk;
+}
+
+static inline size_t par_chunk_end(ParCtx *c, size_t start) {
+    return c->v->len - start < c->chunk ? c->v->len : start + c->chunk;
+}
+
+static void for_each_task(size_t idx, void *arg) {
+    ParCtx *c = arg;
+    Func_Elem func = c->func.elem;
+    size_t i, end;
+
+    end = par_chunk_end(c, idx * c->chunk);
+    for (i = idx * c->chunk; i < end; i++)
+        func(par_ptr(c->v, i), c->ctx);
+}
+
+static void map_task(size_t idx, void *arg) {
+    ParCtx *c = arg;
+    Func_Map map = c->func.map;
+    size_t i, end;
+
+    end = par_chunk_end(c, idx * c->chunk);
+    for (i = idx * c->chunk; i < end; i++)
+        map(par_ptr(c->dest, i), par_ptr(c->v, i), c->ctx);
+}
+
+static void reduce_task(size_t idx, void *arg) {
+    ParCtx *c = arg;
+    Func_Fold fold = c->func.fold;
+    char *acc;
+    size_t i, end;
+
+    acc = c->accs + idx * c->acc_szof;
+    end = par_chunk_end(c, idx * c->chunk);
+    for (i = idx * c->chunk; i < end; i++)
+        fold(acc, par_ptr(c->v, i), c->ctx);
+}
+
+/********************************************************************************************
+ *                                        MERGE SORT                                        *
+ ********************************************************************************************/
+
+typedef struct SortCtx {
+    Vec *v;
+    Func_Cmp cmp;
+    size_t chunk; /* elements per initial run and per merge task */
+    size_t width; /* elements per run */
+    char *src;
+    char *dst;
+} SortCtx;
+
+static void sort_run_task(size_t idx, void *arg) {
+    SortCtx *c = arg;
+    Vec run;
+    size_t start;
+
+    start = idx * c->chunk;
+
+    // a Vec aliasing the run, never freed
+    vec_new(&run, c->v->szof);
+    run.ptr = par_ptr(c->v, start);
+    run.len = c->v->len - start < c->chunk ? c->v->len - start : c->chunk;
+    run.cap = run.len;
+
+    vec_sort(&run, c->cmp);
+}
+
+/**
+ * @brief how many of the first @p k merged elements come from @p l
+ *
+ * binary search on the merge path, ties go to the left like in merge_task()
+ *
+ * @param c SortCtx
+ * @param l left run
+ * @param nl elements of the left run
+ * @param r right run
+ * @param nr elements of the right run
+ * @param k elements of the merge
+ * @return elements taken from @p l
+ */
+static size_t merge_corank(
+    SortCtx *c,
+    const char *l,
+    size_t nl,
+    const char *r,
+    size_t nr,
+    size_t k
+) {
+    size_t szof, lo, hi, i;
+
+    szof = c->v->szof;
+    lo = k > nr ? k - nr : 0;
+    hi = k < nl ? k : nl;
+    while (lo < hi) {
+        i = lo + (hi - lo) / 2;
+        if (c->cmp(r + (k - i - 1) * szof, l + i * szof) >= 0)
+            lo = i + 1;
+        else
+            hi = i;
+    }
+
+    return lo;
+}
+
+/*
+ * every task writes c->chunk elements of the output of a round, so all the threads
+ * work even when the last two runs are merged. a pair of runs is 2 * width elements,
+ * a multiple of chunk, so a task never spans two pairs
+ */
+static void merge_task(size_t idx, void *arg) {
+    SortCtx *c = arg;
+    size_t szof, len, lo, mid, hi, start, end, nl, nr, l_first, l_last;
+    char *l, *l_end, *r, *r_end, *out;
+
+    szof = c->v->szof;
+    len = c->v->len;
+    lo = idx * c->chunk / (2 * c->width) * (2 * c->width);
+    mid = len - lo < c->width ? len : lo + c->width;
+    hi = len - mid < c->width ? len : mid + c->width;
+
+    start = idx * c->chunk;
+    end = len - start < c->chunk ? len : start + c->chunk;
+
+    // where the part of the output [start, end) comes from
+    l = c->src + lo * szof;
+    r = c->src + mid * szof;
+    nl = mid - lo;
+    nr = hi - mid;
+    l_first = merge_corank(c, l, nl, r, nr, start - lo);
+    l_last = merge_corank(c, l, nl, r, nr, end - lo);
+
+    l_end = l + l_last * szof;
+    r_end = r + (end - lo - l_last) * szof;
+    l += l_first * szof;
+    r += (start - lo - l_first) * szof;
+    out = c->dst + start * szof;
+
+    // taking from the left on equal elements keeps the merge stable
+    while (l < l_end && r < r_end) {
+        if (c->cmp(r, l) < 0) {
+            memcpy(out, r, szof);
+            r += szof;
+        } else {
+            memcpy(out, l, szof);
+            l += szof;
+        }
+        out += szof;
+    }
+    memcpy(out, l, l_end - l);
+    out += l_end - l;
+    memcpy(out, r, r_end - r);
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void vec_par_for_each(ThreadPool *pool, Vec *v, Func_Elem func, void *ctx) {
+    ParCtx c;
+
+    c.v = v;
+    c.func.elem = func;
+    c.ctx = ctx;
+    threadpool_run(pool, par_chunks(&c), for_each_task, &c);
+}
+
+void vec_par_map_into(
+    ThreadPool *pool,
+    Vec *dest,
+    Vec *source,
+    Func_Map map,
+    void *ctx
+) {
+    ParCtx c;
+
+    vec_truncate(dest);
+    vec_reserve(dest, source->len);
+    dest->len = source->len;
+
+    c.v = source;
+    c.dest = dest;
+    c.func.map = map;
+    c.ctx = ctx;
+    threadpool_run(pool, par_chunks(&c), map_task, &c);
+}
+
+void vec_par_reduce(
+    ThreadPool *pool,
+    Vec *v,
+    void *acc,
+    size_t acc_szof,
+    Func_Fold fold,
+    Func_Fold combine,
+    void *ctx
+) {
+    ParCtx c;
+    size_t nchunks, i;
+
+    c.v = v;
+    c.func.fold = fold;
+    c.ctx = ctx;
+    c.acc_szof = acc_szof;
+    if (!(nchunks = par_chunks(&c)))
+        return;
+
+    c.accs = malloc(nchunks * acc_szof);
+    for (i = 0; i < nchunks; i++)
+        memcpy(c.accs + i * acc_szof, acc, acc_szof);
+
+    threadpool_run(pool, nchunks, reduce_task, &c);
+
+    memcpy(acc, c.accs, acc_szof);
+    for (i = 1; i < nchunks; i++)
+        combine(acc, c.accs + i * acc_szof, ctx);
+
+    free(c.accs);
+}
+
+void vec_par_sort(ThreadPool *pool, Vec *v, Func_Cmp cmp) {
+    SortCtx c;
+    size_t nchunks, nbytes;
+    char *scratch, *tmp;
+
+    if (v->len < 2)
+        return;
+
+    c.v = v;
+    c.cmp = cmp;
+    c.chunk = CHUNK_BYTES / v->szof;
+    if (!c.chunk)
+        c.chunk = 1;
+    nchunks = (v->len + c.chunk - 1) / c.chunk;
+
+    if (nchunks < 2) {
+        vec_sort(v, cmp);
+        return;
+    }
+
+    nbytes = v->len * v->szof;
+    if ((scratch = malloc(nbytes)) == NULL) {
+        vec_sort(v, cmp);
+        return;
+    }
+
+    threadpool_run(pool, nchunks, sort_run_task, &c);
+
+    // every round merges pairs of runs, split in the same number of tasks
+    c.src = v->ptr;
+    c.dst = scratch;
+    for (c.width = c.chunk; c.width < v->len; c.width *= 2) {
+        threadpool_run(pool, nchunks, merge_task, &c);
+
+        tmp = c.src;
+        c.src = c.dst;
+        c.dst = tmp;
+    }
+
+    if (c.src != v->ptr)
+        memcpy(v->ptr, c.src, nbytes);
+
+    free(scratch);
+}
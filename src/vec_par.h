@@ -0,0 +1,97 @@
+/**
+ * @file vec_par.h
+ */
+
+#ifndef __VEC_PAR_H__
+#define __VEC_PAR_H__
+
+#include <stdlib.h>
+
+#include "threadpool.h"
+#include "vec.h"
+#include "vec_sort.h"
+
+/**
+ * @brief callback writing in @p dst the result of mapping @p src
+ */
+typedef void (*Func_Map)(void *dst, const void *src, void *ctx);
+
+/**
+ * @brief callback accumulating @p elem into @p acc
+ */
+typedef void (*Func_Fold)(void *acc, const void *elem, void *ctx);
+
+/**
+ * @brief call @p func on every element, in parallel
+ *
+ * the Vec is split in cache-sized chunks, so @p func must be safe to call concurrently
+ * on different elements. the order of the calls is unspecified
+ *
+ * @param pool ThreadPool
+ * @param v Vec
+ * @param func callback
+ * @param ctx passed to @p func
+ */
+void vec_par_for_each(ThreadPool *pool, Vec *v, Func_Elem func, void *ctx);
+
+/**
+ * @brief fill @p dest with the result of @p map on every element of @p source, in parallel
+ *
+ * @p dest is overwritten and gets the same length as @p source,
+ * its elements can be of a different size than @p source 's
+ *
+ * @param pool ThreadPool
+ * @param dest Vec
+ * @param source Vec
+ * @param map callback
+ * @param ctx passed to @p map
+ */
+void vec_par_map_into(
+    ThreadPool *pool,
+    Vec *dest,
+    Vec *source,
+    Func_Map map,
+    void *ctx
+);
+
+/**
+ * @brief reduce the elements into @p acc, in parallel
+ *
+ * every chunk starts from a copy of @p acc 's initial value, which must be an identity for @p combine,
+ * and folds its elements in it with @p fold. the chunks' results are then combined in order with @p combine,
+ * so the result doesn't depend on the scheduling as long as @p combine is associative
+ *
+ * @param pool ThreadPool
+ * @param v Vec
+ * @param acc accumulator, holds the identity before the call and the result after
+ * @param acc_szof size of the accumulator
+ * @param fold callback accumulating an element
+ * @param combine callback accumulating a chunk's result
+ * @param ctx passed to @p fold and @p combine
+ */
+void vec_par_reduce(
+    ThreadPool *pool,
+    Vec *v,
+    void *acc,
+    size_t acc_szof,
+    Func_Fold fold,
+    Func_Fold combine,
+    void *ctx
+);
+
+/**
+ * @brief sort the Vec, in parallel
+ *
+ * the Vec is split in cache-sized runs sorted with vec_sort(), then the runs are merged pairwise.
+ * every merge is split in cache-sized parts by a binary search, so all the threads work at every
+ * round, the last one included.
+ * needs a scratch buffer as big as the Vec, taken from malloc: if it can't be allocated, the Vec
+ * is sorted by vec_sort() on the calling thread
+ *
+ * @param pool ThreadPool
+ * @param v Vec
+ * @param cmp comparison function, called concurrently
+ */
+void vec_par_sort(ThreadPool *pool, Vec *v, Func_Cmp cmp);
+
+#endif /* __VEC_PAR_H__ */
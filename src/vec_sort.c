@@ -0,0 +1,494 @@
+#include "vec_sort.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INSERTION_THRESHOLD (16UL)
+
+typedef void (*Func_Swap)(char *, char *, size_t);
+
+/********************************************************************************************
+ *                                      SWAP KERNELS                                        *
+ ********************************************************************************************/
+
+/* with a constant size the memcpy()s become plain loads and stores */
+#define SWAP_KERNEL(name, size) \
+    static void name(char *a, char *b, size_t szof) { \
+        unsigned char tmp[size]; \
+\
+        (void)szof; \
+        memcpy(tmp, a, size); \
+        memcpy(a, b, size); \
+        memcpy(b, tmp, size); \
+    }
+
+SWAP_KERNEL(swap_1, 1)
+SWAP_KERNEL(swap_2, 2)
+SWAP_KERNEL(swap_4, 4)
+SWAP_KERNEL(swap_8, 8)
+SWAP_KERNEL(swap_16, 16)
+
+static void swap_n(char *a, char *b, size_t szof) {
+    uint64_t tmp;
+
+    for (; szof >= sizeof(tmp);
+         szof -= sizeof(tmp), a += sizeof(tmp), b += sizeof(tmp)) {
+        memcpy(&tmp, a, sizeof(tmp));
+        memcpy(a, b, sizeof(tmp));
+        memcpy(b, &tmp, sizeof(tmp));
+    }
+    for (; szof; szof--, a++, b++) {
+        char c = *a;
+        *a = *b;
+        *b = c;
+    }
+}
+
+static Func_Swap swap_for(size_t szof) {
+    switch (szof) {
+        case 1:
+            return swap_1;
+        case 2:
+            return swap_2;
+        case 4:
+            return swap_4;
+        case 8:
+            return swap_8;
+        case 16:
+            return swap_16;
+        default:
+            return swap_n;
+    }
+}
+
+static inline void copy_elem(char *dst, const char *src, size_t szof) {
+    switch (szof) {
+        case 4:
+            memcpy(dst, src, 4);
+            break;
+        case 8:
+            memcpy(dst, src, 8);
+            break;
+        case 16:
+            memcpy(dst, src, 16);
+            break;
+        default:
+            memcpy(dst, src, szof);
+            break;
+    }
+}
+
+/********************************************************************************************
+ *                                         INTROSORT                                        *
+ ********************************************************************************************/
+
+typedef struct SortCtx {
+    Func_Cmp cmp;
+    Func_Swap swap;
+    size_t szof;
+} SortCtx;
+
+static void insertion_sort(char *base, size_t n, const SortCtx *c) {
+    size_t i, j;
+
+    for (i = 1; i < n; i++) {
+        char *curr = base + i * c->szof;
+
+        for (j = i; j && c->cmp(curr - c->szof, curr) > 0;
+             j--, curr -= c->szof)
+            c->swap(curr - c->szof, curr, c->szof);
+    }
+}
+
+static void sift_down(char *base, size_t root, size_t n, const SortCtx *c) {
+    size_t child;
+
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n
+            && c->cmp(base + child * c->szof, base + (child + 1) * c->szof) < 0)
+            child++;
+        if (c->cmp(base + root * c->szof, base + child * c->szof) >= 0)
+            return;
+        c->swap(base + root * c->szof, base + child * c->szof, c->szof);
+        root = child;
+    }
+}
+
+static void heap_sort(char *base, size_t n, const SortCtx *c) {
+    size_t i;
+
+    for (i = n / 2; i > 0; i--)
+        sift_down(base, i - 1, n, c);
+    for (i = n - 1; i > 0; i--) {
+        c->swap(base, base + i * c->szof, c->szof);
+        sift_down(base, 0, i, c);
+    }
+}
+
+static void introsort(char *base, size_t n, size_t depth, const SortCtx *c) {
+    while (n > INSERTION_THRESHOLD) {
+        char *mid, *last;
+        size_t i, j;
+
+        if (!depth) {
+            heap_sort(base, n, c);
+            return;
+        }
+        depth--;
+
+        // median of three, moved at the beginning as pivot
+        mid = base + (n / 2) * c->szof;
+        last = base + (n - 1) * c->szof;
+        if (c->cmp(mid, base) < 0)
+            c->swap(mid, base, c->szof);
+        if (c->cmp(last, mid) < 0) {
+            c->swap(last, mid, c->szof);
+            if (c->cmp(mid, base) < 0)
+                c->swap(mid, base, c->szof);
+        }
+        c->swap(base, mid, c->szof);
+
+        // hoare partition, stopping on equal elements to keep it balanced
+        i = 0;
+        j = n;
+        for (;;) {
+            do
+                i++;
+            while (i < n && c->cmp(base + i * c->szof, base) < 0);
+            do
+                j--;
+            while (c->cmp(base + j * c->szof, base) > 0);
+            if (i >= j)
+                break;
+            c->swap(base + i * c->szof, base + j * c->szof, c->szof);
+        }
+        c->swap(base, base + j * c->szof, c->szof);
+
+        // recurse on the smaller side, loop on the bigger one
+        if (j < n - j - 1) {
+            introsort(base, j, depth, c);
+            base += (j + 1) * c->szof;
+            n -= j + 1;
+        } else {
+            introsort(base + (j + 1) * c->szof, n - j - 1, depth, c);
+            n = j;
+        }
+    }
+
+    insertion_sort(base, n, c);
+}
+
+/********************************************************************************************
+ *                                        RADIX SORT                                        *
+ ********************************************************************************************/
+
+/* maps the key to an unsigned integer with the same ordering */
+static inline uint64_t radix_key(const char *elem, VecKey key) {
+    uint32_t k32;
+    uint64_t k64;
+
+    switch (key) {
+        case VEC_KEY_U32:
+            memcpy(&k32, elem, sizeof(k32));
+            return k32;
+        case VEC_KEY_I32:
+            memcpy(&k32, elem, sizeof(k32));
+            return k32 ^ 0x80000000UL;
+        case VEC_KEY_F32:
+            memcpy(&k32, elem, sizeof(k32));
+            return (k32 & 0x80000000UL) ? (uint32_t)~k32 : k32 ^ 0x80000000UL;
+        case VEC_KEY_U64:
+            memcpy(&k64, elem, sizeof(k64));
+            return k64;
+        case VEC_KEY_I64:
+            memcpy(&k64, elem, sizeof(k64));
+            return k64 ^ 0x8000000000000000ULL;
+        case VEC_KEY_F64:
+        default:
+            memcpy(&k64, elem, sizeof(k64));
+            return (k64 & 0x8000000000000000ULL) ? ~k64
+                                                 : k64 ^ 0x8000000000000000ULL;
+    }
+}
+
+/********************************************************************************************
+ *                                 IN-PLACE STABLE FALLBACK                                 *
+ ********************************************************************************************/
+
+/* used by vec_radix_sort() when the scratch buffer can't be allocated */
+
+typedef struct KeyCtx {
+    Func_Swap swap;
+    size_t szof;
+    size_t key_offset;
+    VecKey key;
+} KeyCtx;
+
+static inline bool
+key_less(char *base, size_t i, size_t j, const KeyCtx *c) {
+    return radix_key(base + i * c->szof + c->key_offset, c->key)
+        < radix_key(base + j * c->szof + c->key_offset, c->key);
+}
+
+static inline void
+key_swap(char *base, size_t i, size_t j, const KeyCtx *c) {
+    c->swap(base + i * c->szof, base + j * c->szof, c->szof);
+}
+
+static void
+key_insertion_sort(char *base, size_t a, size_t b, const KeyCtx *c) {
+    size_t i, j;
+
+    for (i = a + 1; i < b; i++) {
+        for (j = i; j > a && key_less(base, j, j - 1, c); j--)
+            key_swap(base, j, j - 1, c);
+    }
+}
+
+static void
+key_swap_range(char *base, size_t a, size_t b, size_t n, const KeyCtx *c) {
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        key_swap(base, a + i, b + i, c);
+}
+
+/* swap the adjacent ranges [a, m) and [m, b) */
+static void
+key_rotate(char *base, size_t a, size_t m, size_t b, const KeyCtx *c) {
+    size_t i, j;
+
+    i = m - a;
+    j = b - m;
+    while (i != j) {
+        if (i > j) {
+            key_swap_range(base, m - i, m, j, c);
+            i -= j;
+        } else {
+            key_swap_range(base, m - i, m + j - i, i, c);
+            j -= i;
+        }
+    }
+    key_swap_range(base, m - i, m, i, c);
+}
+
+/*
+ * stable merge of the sorted ranges [a, m) and [m, b) without extra memory
+ * (SymMerge, Kim and Kutzner), both ranges must not be empty
+ */
+static void
+key_merge(char *base, size_t a, size_t m, size_t b, const KeyCtx *c) {
+    size_t i, j, h, mid, n, start, r, end;
+
+    // a single element is moved in place after a binary search
+    if (m - a == 1) {
+        for (i = m, j = b; i < j;) {
+            h = i + (j - i) / 2;
+            if (key_less(base, h, a, c))
+                i = h + 1;
+            else
+                j = h;
+        }
+        for (h = a; h + 1 < i; h++)
+            key_swap(base, h, h + 1, c);
+        return;
+    }
+    if (b - m == 1) {
+        for (i = a, j = m; i < j;) {
+            h = i + (j - i) / 2;
+            if (!key_less(base, m, h, c))
+                i = h + 1;
+            else
+                j = h;
+        }
+        for (h = m; h > i; h--)
+            key_swap(base, h, h - 1, c);
+        return;
+    }
+
+    mid = a + (b - a) / 2;
+    n = mid + m;
+    if (m > mid) {
+        start = n - b;
+        r = mid;
+    } else {
+        start = a;
+        r = m;
+    }
+    while (start < r) {
+        h = start + (r - start) / 2;
+        if (!key_less(base, n - 1 - h, h, c))
+            start = h + 1;
+        else
+            r = h;
+    }
+    end = n - start;
+
+    if (start < m && m < end)
+        key_rotate(base, start, m, end, c);
+    if (a < start && start < mid)
+        key_merge(base, a, start, mid, c);
+    if (mid < end && end < b)
+        key_merge(base, mid, end, b, c);
+}
+
+/* insertion sort of small blocks, then merges of blocks twice as big at every round */
+static void key_stable_sort(char *base, size_t n, const KeyCtx *c) {
+    size_t block, a, end;
+
+    for (a = 0; a < n; a = end) {
+        end = n - a < INSERTION_THRESHOLD ? n : a + INSERTION_THRESHOLD;
+        key_insertion_sort(base, a, end, c);
+    }
+
+    for (block = INSERTION_THRESHOLD; block < n; block *= 2) {
+        for (a = 0; n - a > block; a = end) {
+            end = n - a - block < block ? n : a + 2 * block;
+            key_merge(base, a, a + block, end, c);
+        }
+    }
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void vec_sort(Vec *v, Func_Cmp cmp) {
+    SortCtx c;
+    size_t depth, n;
+
+    if (v->len < 2)
+        return;
+
+    c.cmp = cmp;
+    c.swap = swap_for(v->szof);
+    c.szof = v->szof;
+
+    for (depth = 0, n = v->len; n > 1; n >>= 1)
+        depth += 2;
+
+    introsort(v->ptr, v->len, depth, &c);
+}
+
+void vec_radix_sort(Vec *v, size_t key_offset, VecKey key) {
+    size_t counts[8][256];
+    size_t nbytes, i, d, nbuf;
+    char *src, *dst, *tmp, *scratch;
+
+    if (v->len < 2)
+        return;
+
+    nbytes = (key == VEC_KEY_U32 || key == VEC_KEY_I32 || key == VEC_KEY_F32)
+        ? 4
+        : 8;
+
+    // histograms of every digit in a single pass
+    memset(counts, 0, sizeof(counts));
+    src = v->ptr;
+    for (i = 0; i < v->len; i++) {
+        uint64_t k = radix_key(src + i * v->szof + key_offset, key);
+
+        for (d = 0; d < nbytes; d++)
+            counts[d][(k >> (d * 8)) & 0xFF]++;
+    }
+
+    nbuf = v->len * v->szof;
+    if ((scratch = malloc(nbuf)) == NULL) {
+        KeyCtx c;
+
+        c.swap = swap_for(v->szof);
+        c.szof = v->szof;
+        c.key_offset = key_offset;
+        c.key = key;
+        key_stable_sort(v->ptr, v->len, &c);
+        return;
+    }
+    dst = scratch;
+
+    for (d = 0; d < nbytes; d++) {
+        size_t offsets[256], sum;
+
+        // every key has the same digit, nothing would move
+        if (counts[d][(radix_key(src + key_offset, key) >> (d * 8)) & 0xFF]
+            == v->len)
+            continue;
+
+        for (i = 0, sum = 0; i < 256; i++) {
+            offsets[i] = sum;
+            sum += counts[d][i];
+        }
+
+        for (i = 0; i < v->len; i++) {
+            const char *elem = src + i * v->szof;
+            uint64_t k = radix_key(elem + key_offset, key);
+
+            copy_elem(
+                dst + offsets[(k >> (d * 8)) & 0xFF]++ * v->szof,
+                elem,
+                v->szof
+            );
+        }
+
+        // the sorted elements become the source of the next pass
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != v->ptr)
+        memcpy(v->ptr, src, nbuf);
+
+    free(scratch);
+}
+
+size_t vec_lower_bound(Vec *v, const void *key, Func_Cmp cmp) {
+    size_t lo, n;
+
+    lo = 0;
+    n = v->len;
+    while (n) {
+        size_t half = n / 2;
+
+        if (cmp(key, (char *)v->ptr + (lo + half) * v->szof) > 0) {
+            lo += half + 1;
+            n -= half + 1;
+        } else
+            n = half;
+    }
+
+    return lo;
+}
+
+void *vec_bsearch(Vec *v, const void *key, Func_Cmp cmp) {
+    size_t pos;
+    char *elem;
+
+    pos = vec_lower_bound(v, key, cmp);
+    if (pos < v->len) {
+        elem = (char *)v->ptr + pos * v->szof;
+        if (cmp(key, elem) == 0)
+            return elem;
+    }
+
+    return NULL;
+}
+
+void vec_dedup(Vec *v, Func_Cmp cmp) {
+    size_t i, last;
+    char *base;
+
+    if (v->len < 2)
+        return;
+
+    base = v->ptr;
+    for (i = 1, last = 0; i < v->len; i++) {
+        if (cmp(base + last * v->szof, base + i * v->szof) != 0) {
+            last++;
+            if (last != i)
+                copy_elem(base + last * v->szof, base + i * v->szof, v->szof);
+        }
+    }
+    v->len = last + 1;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file vec_sort.h
+ */
+
+#ifndef __VEC_SORT_H__
+#define __VEC_SORT_H__
+
+#include <stdlib.h>
+
+#include "vec.h"
+
+/**
+ * @brief callback to compare two elements, same contract as qsort()'s
+ */
+typedef int (*Func_Cmp)(const void *, const void *);
+
+/**
+ * @brief type of the key used by vec_radix_sort()
+ */
+typedef enum VecKey {
+    VEC_KEY_U32, /**< uint32_t */
+    VEC_KEY_I32, /**< int32_t */
+    VEC_KEY_U64, /**< uint64_t */
+    VEC_KEY_I64, /**< int64_t */
+    VEC_KEY_F32, /**< float, NaNs are sorted by their bit pattern */
+    VEC_KEY_F64, /**< double, NaNs are sorted by their bit pattern */
+} VecKey;
+
+/**
+ * @brief sort the Vec in place
+ *
+ * introsort (quicksort falling back to heapsort, insertion sort on small ranges), not stable.
+ * elements are swapped with kernels specialized for sizes 1, 2, 4, 8 and 16
+ *
+ * @param v Vec
+ * @param cmp comparison function
+ */
+void vec_sort(Vec *v, Func_Cmp cmp);
+
+/**
+ * @brief sort the Vec by a numeric key contained in each element
+ *
+ * LSD radix sort, stable. needs a scratch buffer as big as the Vec, taken from malloc.
+ * passes on bytes that are the same for every key are skipped.
+ * if the buffer can't be allocated, it falls back to an in-place stable merge sort, O(n log^2 n)
+ *
+ * @param v Vec
+ * @param key_offset offset of the key inside the element (e.g. offsetof())
+ * @param key type of the key
+ */
+void vec_radix_sort(Vec *v, size_t key_offset, VecKey key);
+
+/**
+ * @brief index of the first element not less than @p key, or the length if there's none
+ *
+ * the Vec must be sorted according to @p cmp, which is called as cmp(key, element)
+ *
+ * @param v Vec
+ * @param key key to search
+ * @param cmp comparison function
+ * @return index of the element
+ */
+size_t vec_lower_bound(Vec *v, const void *key, Func_Cmp cmp);
+
+/**
+ * @brief binary search of @p key
+ *
+ * the Vec must be sorted according to @p cmp, which is called as cmp(key, element)
+ *
+ * @param v Vec
+ * @param key key to search
+ * @param cmp comparison function
+ * @return pointer to the first element equal to @p key, or NULL
+ */
+void *vec_bsearch(Vec *v, const void *key, Func_Cmp cmp);
+
+/**
+ * @brief remove consecutive equal elements, keeping the first of each run
+ *
+ * on sorted data, leaves only unique elements.
+ * doesn't deallocate memory. if the elements own memory, the removed ones are lost
+ *
+ * @param v Vec
+ * @param cmp comparison function
+ */
+void vec_dedup(Vec *v, Func_Cmp cmp);
+
+#endif /* __VEC_SORT_H__ */
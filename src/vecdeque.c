@@ -0,0 +1,188 @@
+#include "vecdeque.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_CAP (4UL)
+
+/********************************************************************************************
+ *                                     PRIVATE METHODS                                      *
+ ********************************************************************************************/
+
+static inline char *dq_ptr(VecDeque *dq, size_t idx) {
+    return ((char *)dq->ptr) + (idx * dq->szof);
+}
+
+/* index in the buffer of the element at pos */
+static inline size_t dq_idx(VecDeque *dq, size_t pos) {
+    return (dq->head + pos) & (dq->cap - 1);
+}
+
+/**
+ * @brief grow to the power of two fitting @p nelem
+ *
+ * if the elements were wrapping around, the part at the beginning of the buffer
+ * is moved after the old end, which is always big enough since the capacity at least doubles
+ *
+ * @param dq VecDeque
+ * @param nelem number of elements requested
+ */
+static void vecdeque_grow(VecDeque *dq, size_t nelem) {
+    size_t cap, wrapped;
+
+    cap = dq->cap ? dq->cap : MIN_CAP;
+    while (cap < nelem)
+        cap *= 2;
+
+    if (dq->cap)
+        dq->ptr = allocator_realloc(
+            dq->allocator,
+            dq->ptr,
+            dq->cap * dq->szof,
+            cap * dq->szof
+        );
+    else
+        dq->ptr = allocator_alloc(dq->allocator, cap * dq->szof);
+
+    if (dq->head + dq->len > dq->cap) {
+        wrapped = dq->head + dq->len - dq->cap;
+        memcpy(dq_ptr(dq, dq->cap), dq_ptr(dq, 0), wrapped * dq->szof);
+    }
+
+    dq->cap = cap;
+}
+
+/**
+ * @brief copy @p nelem elements between @p buf and the circular buffer starting at @p idx
+ *
+ * @param dq VecDeque
+ * @param idx index in the buffer
+ * @param buf linear array
+ * @param nelem number of elements
+ * @param to_dq direction of the copy
+ */
+static void
+dq_copy(VecDeque *dq, size_t idx, char *buf, size_t nelem, bool to_dq) {
+    size_t first;
+
+    first = dq->cap - idx;
+    if (first > nelem)
+        first = nelem;
+
+    if (to_dq) {
+        memcpy(dq_ptr(dq, idx), buf, first * dq->szof);
+        memcpy(dq_ptr(dq, 0), buf + first * dq->szof, (nelem - first) * dq->szof);
+    } else {
+        memcpy(buf, dq_ptr(dq, idx), first * dq->szof);
+        memcpy(buf + first * dq->szof, dq_ptr(dq, 0), (nelem - first) * dq->szof);
+    }
+}
+
+/********************************************************************************************
+ *                                      PUBLIC METHODS                                      *
+ ********************************************************************************************/
+
+void vecdeque_new(VecDeque *dq, size_t szof) {
+    dq->ptr = NULL;
+    dq->cap = 0;
+    dq->len = 0;
+    dq->szof = szof;
+    dq->head = 0;
+    dq->allocator = NULL;
+}
+
+void vecdeque_new_in(VecDeque *dq, size_t szof, const Allocator *allocator) {
+    vecdeque_new(dq, szof);
+    dq->allocator = allocator;
+}
+
+void vecdeque_new_with(VecDeque *dq, size_t szof, size_t nelem) {
+    vecdeque_new(dq, szof);
+    vecdeque_reserve(dq, nelem);
+}
+
+void vecdeque_free(VecDeque *dq) {
+    if (dq->cap)
+        allocator_free(dq->allocator, dq->ptr, dq->cap * dq->szof);
+    dq->ptr = NULL;
+    dq->cap = 0;
+    dq->len = 0;
+    dq->head = 0;
+}
+
+void vecdeque_reserve(VecDeque *dq, size_t nelem) {
+    if (nelem > dq->cap)
+        vecdeque_grow(dq, nelem);
+}
+
+void vecdeque_push_back(VecDeque *dq, void *elem) {
+    if (dq->len == dq->cap)
+        vecdeque_grow(dq, dq->len + 1);
+    memcpy(dq_ptr(dq, dq_idx(dq, dq->len)), elem, dq->szof);
+    dq->len++;
+}
+
+void vecdeque_push_front(VecDeque *dq, void *elem) {
+    if (dq->len == dq->cap)
+        vecdeque_grow(dq, dq->len + 1);
+    dq->head = (dq->head - 1) & (dq->cap - 1);
+    memcpy(dq_ptr(dq, dq->head), elem, dq->szof);
+    dq->len++;
+}
+
+bool vecdeque_pop_back(VecDeque *dq, void *elem) {
+    if (!dq->len)
+        return false;
+    dq->len--;
+    if (elem)
+        memcpy(elem, dq_ptr(dq, dq_idx(dq, dq->len)), dq->szof);
+    return true;
+}
+
+bool vecdeque_pop_front(VecDeque *dq, void *elem) {
+    if (!dq->len)
+        return false;
+    if (elem)
+        memcpy(elem, dq_ptr(dq, dq->head), dq->szof);
+    dq->head = (dq->head + 1) & (dq->cap - 1);
+    dq->len--;
+    return true;
+}
+
+void vecdeque_push_back_n(VecDeque *dq, void *elems, size_t nelem) {
+    if (!nelem)
+        return;
+    vecdeque_reserve(dq, dq->len + nelem);
+    dq_copy(dq, dq_idx(dq, dq->len), elems, nelem, true);
+    dq->len += nelem;
+}
+
+size_t vecdeque_pop_front_n(VecDeque *dq, void *elems, size_t nelem) {
+    if (nelem > dq->len)
+        nelem = dq->len;
+    if (!nelem)
+        return 0;
+    if (elems)
+        dq_copy(dq, dq->head, elems, nelem, false);
+    dq->head = dq_idx(dq, nelem);
+    dq->len -= nelem;
+    return nelem;
+}
+
+void vecdeque_as_slices(
+    VecDeque *dq,
+    void **first,
+    size_t *first_len,
+    void **second,
+    size_t *second_len
+) {
+    if (dq->head + dq->len > dq->cap) {
+        *first_len = dq->cap - dq->head;
+        *second_len = dq->len - *first_len;
+    } else {
+        *first_len = dq->len;
+        *second_len = 0;
+    }
+    *first = dq->len ? dq_ptr(dq, dq->head) : NULL;
+    *second = *second_len ? dq->ptr : NULL;
+}
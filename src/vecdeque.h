@@ -0,0 +1,185 @@
+/**
+ * @file vecdeque.h
+ */
+
+#ifndef __VECDEQUE_H__
+#define __VECDEQUE_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "allocator.h"
+
+/**
+ * @brief double-ended queue on a circular buffer
+ *
+ * same layout conventions as Vec. the capacity is always a power of two,
+ * so positions wrap around with a mask
+ */
+typedef struct VecDeque {
+    void *ptr;  /**< underlying data, the elements can wrap around its end */
+    size_t cap; /**< number of elements for which there is space allocated */
+    size_t len; /**< number of usable elements */
+    size_t szof; /**< sizeof() of the data type to be held */
+    size_t head; /**< index in @p ptr of the first element */
+    const Allocator *allocator; /**< where the memory comes from, NULL for malloc */
+} VecDeque;
+
+/**
+ * @brief new VecDeque
+ *
+ * the VecDeque is not allocated
+ *
+ * @param dq VecDeque
+ * @param szof size of the single elements it's going to contain
+ */
+void vecdeque_new(VecDeque *dq, size_t szof);
+
+/**
+ * @brief new VecDeque using @p allocator for its memory
+ *
+ * @param dq VecDeque
+ * @param szof size of the single elements it's going to contain
+ * @param allocator Allocator, must outlive the VecDeque. NULL for malloc
+ */
+void vecdeque_new_in(VecDeque *dq, size_t szof, const Allocator *allocator);
+
+/**
+ * @brief new VecDeque with reserved space
+ *
+ * @param dq VecDeque
+ * @param szof size of the single elements it's going to contain
+ * @param nelem number of elements to reserve memory for
+ */
+void vecdeque_new_with(VecDeque *dq, size_t szof, size_t nelem);
+
+/**
+ * @brief release memory
+ *
+ * if the single elements own memory, that needs to be release before by the caller
+ *
+ * @param dq VecDeque
+ */
+void vecdeque_free(VecDeque *dq);
+
+/**
+ * @brief empty the VecDeque but don't free the memory, so it can be reused
+ *
+ * @param dq VecDeque
+ */
+inline void vecdeque_truncate(VecDeque *dq) {
+    dq->len = 0;
+    dq->head = 0;
+}
+
+/**
+ * @brief reserve memory ahead of time
+ *
+ * @param dq VecDeque
+ * @param nelem number of elements to reserve memory for
+ */
+void vecdeque_reserve(VecDeque *dq, size_t nelem);
+
+/**
+ * @brief return pointer to element at pos, counting from the front
+ *
+ * if changes to the VecDeque are made, this pointer can become invalid
+ *
+ * @param dq VecDeque
+ * @param pos index of the element
+ * @return pointer to element, or NULL
+ */
+inline void *vecdeque_elem_at(VecDeque *dq, size_t pos) {
+    if (pos < dq->len)
+        return ((char *)dq->ptr)
+            + (((dq->head + pos) & (dq->cap - 1)) * dq->szof);
+    return NULL;
+}
+
+/**
+ * @brief insert element at the end through shallow-copy
+ *
+ * @param dq VecDeque
+ * @param elem element to insert
+ */
+void vecdeque_push_back(VecDeque *dq, void *elem);
+
+/**
+ * @brief insert element at the beginning through shallow-copy
+ *
+ * @param dq VecDeque
+ * @param elem element to insert
+ */
+void vecdeque_push_front(VecDeque *dq, void *elem);
+
+/**
+ * @brief remove element from the end
+ *
+ * @param dq VecDeque
+ * @param elem element removed, can be NULL
+ * @return false if the VecDeque was empty
+ */
+bool vecdeque_pop_back(VecDeque *dq, void *elem);
+
+/**
+ * @brief remove element from the beginning
+ *
+ * @param dq VecDeque
+ * @param elem element removed, can be NULL
+ * @return false if the VecDeque was empty
+ */
+bool vecdeque_pop_front(VecDeque *dq, void *elem);
+
+/**
+ * @brief bulk insert of elements at the end through shallow-copy
+ *
+ * copies with at most two memcpy
+ *
+ * @param dq VecDeque
+ * @param elems array of elements
+ * @param nelem number of elements of the array
+ */
+void vecdeque_push_back_n(VecDeque *dq, void *elems, size_t nelem);
+
+/**
+ * @brief bulk remove of elements from the beginning
+ *
+ * copies with at most two memcpy
+ *
+ * @param dq VecDeque
+ * @param elems elements removed, can be NULL
+ * @param nelem max number of elements to remove
+ * @return number of elements removed
+ */
+size_t vecdeque_pop_front_n(VecDeque *dq, void *elems, size_t nelem);
+
+/**
+ * @brief the elements as two contiguous slices, in order
+ *
+ * the second slice is empty unless the elements wrap around the end of the buffer
+ *
+ * @param dq VecDeque
+ * @param first beginning of the first slice
+ * @param first_len number of elements of the first slice
+ * @param second beginning of the second slice
+ * @param second_len number of elements of the second slice
+ */
+void vecdeque_as_slices(
+    VecDeque *dq,
+    void **first,
+    size_t *first_len,
+    void **second,
+    size_t *second_len
+);
+
+/**
+ * @brief if VecDeque is empty
+ *
+ * @param dq VecDeque
+ * @return boolean
+ */
+inline bool vecdeque_is_empty(VecDeque *dq) {
+    return dq->len == 0;
+}
+
+#endif /* __VECDEQUE_H__ */